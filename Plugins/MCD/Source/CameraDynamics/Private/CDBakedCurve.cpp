@@ -0,0 +1,80 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "CDBakedCurve.h"
+#include "CameraDynamics.h"
+
+TSharedPtr<const FCDBakedCurve> FCDBakedCurve::Bake(const FRichCurve& Curve, const FCDCurveBakeSettings& Settings)
+{
+	// Samples are clamped at either end, so only constant extrapolation can be reproduced
+	if (Curve.GetNumKeys() < 2
+		|| Curve.PreInfinityExtrap != RCCE_Constant || Curve.PostInfinityExtrap != RCCE_Constant)
+	{
+		return nullptr;
+	}
+
+	float CurveMinTime, CurveMaxTime, CurveMinValue, CurveMaxValue;
+	Curve.GetTimeRange(CurveMinTime, CurveMaxTime);
+	Curve.GetValueRange(CurveMinValue, CurveMaxValue);
+	if (CurveMaxTime <= CurveMinTime)
+	{
+		return nullptr;
+	}
+
+	// Tangents can overshoot the key values, but the key value range is a good enough scale for the error bound
+	const float Tolerance = Settings.MaxError * FMath::Max(CurveMaxValue - CurveMinValue, 1.0f);
+
+	TSharedRef<FCDBakedCurve> Baked = MakeShared<FCDBakedCurve>();
+	Baked->MinTime = CurveMinTime;
+	Baked->bInterpolate = Settings.bInterpolate;
+
+	for (int32 NumSamples = FMath::Max(Settings.MinSamples, 2); NumSamples <= Settings.MaxSamples; NumSamples *= 2)
+	{
+		Baked->InvSampleInterval = (NumSamples - 1) / (CurveMaxTime - CurveMinTime);
+		if (Baked->SampleCurve(Curve, NumSamples, false, Tolerance))
+		{
+			// Half precision is only used if it also fits the error bound
+			if (Settings.bAllowHalfPrecision)
+			{
+				TSharedRef<FCDBakedCurve> HalfBaked = MakeShared<FCDBakedCurve>(*Baked);
+				if (HalfBaked->SampleCurve(Curve, NumSamples, true, Tolerance))
+				{
+					return HalfBaked;
+				}
+			}
+			return Baked;
+		}
+	}
+
+	UE_LOG(LogCameraDynamics, Verbose, TEXT("Curve with %i keys can't be baked within %f, using the rich curve"),
+	       Curve.GetNumKeys(), Tolerance);
+	return nullptr;
+}
+
+bool FCDBakedCurve::SampleCurve(const FRichCurve& Curve, const int32 NumSamples, const bool bHalf, const float Tolerance)
+{
+	const float SampleInterval = 1.0f / InvSampleInterval;
+	LastSample = static_cast<float>(NumSamples - 1);
+
+	Samples.Reset();
+	HalfSamples.Reset();
+	for (int32 Index = 0; Index < NumSamples; Index++)
+	{
+		const float Value = Curve.Eval(MinTime + Index * SampleInterval);
+		if (bHalf) HalfSamples.Add(FFloat16(Value));
+		else Samples.Add(Value);
+	}
+
+	// Check between every pair of samples, where the error is largest, and at the keys, where the curve can change sharply
+	MaxError = 0.0f;
+	for (int32 Index = 0; Index < NumSamples - 1; Index++)
+	{
+		const float Time = MinTime + (Index + 0.5f) * SampleInterval;
+		MaxError = FMath::Max(MaxError, FMath::Abs(Eval(Time) - Curve.Eval(Time)));
+	}
+	for (auto It = Curve.GetKeyIterator(); It; ++It)
+	{
+		MaxError = FMath::Max(MaxError, FMath::Abs(Eval(It->Time) - It->Value));
+	}
+	return MaxError <= Tolerance;
+}
@@ -0,0 +1,109 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#include "CDCameraBlackboard.h"
+#include "CameraDynamics.h"
+
+int32 FCDCameraBlackboard::Declare(const FCDCameraParameterDefinition& Definition)
+{
+	if (Definition.Name.IsNone()) return INDEX_NONE;
+
+	if (const int32* ExistingSlot = SlotsByName.Find(Definition.Name))
+	{
+		if (Slots[*ExistingSlot].Type == Definition.Type) return *ExistingSlot;
+
+		UE_LOG(LogCameraDynamics, Warning, TEXT("Camera parameter %s is already declared with a different type, ignoring the new declaration"),
+		       *Definition.Name.ToString());
+		return INDEX_NONE;
+	}
+
+	FSlot& NewSlot = Slots.AddDefaulted_GetRef();
+	NewSlot.Name = Definition.Name;
+	NewSlot.Type = Definition.Type;
+	switch (Definition.Type)
+	{
+	case CDPARAM_Float:		NewSlot.ValueIndex = Floats.Add(Definition.DefaultFloat); break;
+	case CDPARAM_Vector:	NewSlot.ValueIndex = Vectors.Add(Definition.DefaultVector); break;
+	case CDPARAM_Rotator:	NewSlot.ValueIndex = Rotators.Add(Definition.DefaultRotator); break;
+	case CDPARAM_Object:	NewSlot.ValueIndex = Objects.Add(Definition.DefaultObject); break;
+	default:				checkNoEntry(); break;
+	}
+
+	const int32 Slot = Slots.Num() - 1;
+	SlotsByName.Add(Definition.Name, Slot);
+	Dirty.Add(false);
+	MarkDirty(Slot);
+	return Slot;
+}
+
+int32 FCDCameraBlackboard::FindSlot(const FName Name, const ECDCameraParameterType Type) const
+{
+	const int32* Slot = SlotsByName.Find(Name);
+	return Slot && Slots[*Slot].Type == Type ? *Slot : INDEX_NONE;
+}
+
+void FCDCameraBlackboard::SetFloat(const int32 Slot, const float Value)
+{
+	Floats[GetValueIndex(Slot, CDPARAM_Float)] = Value;
+	MarkDirty(Slot);
+}
+
+void FCDCameraBlackboard::SetVector(const int32 Slot, const FVector& Value)
+{
+	Vectors[GetValueIndex(Slot, CDPARAM_Vector)] = Value;
+	MarkDirty(Slot);
+}
+
+void FCDCameraBlackboard::SetRotator(const int32 Slot, const FRotator& Value)
+{
+	Rotators[GetValueIndex(Slot, CDPARAM_Rotator)] = Value;
+	MarkDirty(Slot);
+}
+
+void FCDCameraBlackboard::SetObject(const int32 Slot, UObject* Value)
+{
+	Objects[GetValueIndex(Slot, CDPARAM_Object)] = Value;
+	MarkDirty(Slot);
+}
+
+bool FCDCameraBlackboard::IsAnyDirty(const TConstArrayView<int32> InSlots) const
+{
+	if (!bAnyDirty) return false;
+	for (const int32 Slot : InSlots)
+	{
+		if (Dirty[Slot]) return true;
+	}
+	return false;
+}
+
+void FCDCameraBlackboard::ClearDirty()
+{
+	if (!bAnyDirty) return;
+	Dirty.SetRange(0, Dirty.Num(), false);
+	bAnyDirty = false;
+}
+
+bool FCDCameraBlackboard::ShouldRead(const FCDCameraParameterBinding& Binding, const ECDCameraParameterType Type) const
+{
+	return Binding.IsBound() && IsValidSlot(Binding.Slot, Type) && Dirty[Binding.Slot];
+}
+
+bool FCDCameraBlackboard::Read(const FCDCameraParameterBinding& Binding, float& OutValue) const
+{
+	if (!ShouldRead(Binding, CDPARAM_Float)) return false;
+	OutValue = GetFloat(Binding.Slot);
+	return true;
+}
+
+bool FCDCameraBlackboard::Read(const FCDCameraParameterBinding& Binding, FVector& OutValue) const
+{
+	if (!ShouldRead(Binding, CDPARAM_Vector)) return false;
+	OutValue = GetVector(Binding.Slot);
+	return true;
+}
+
+bool FCDCameraBlackboard::Read(const FCDCameraParameterBinding& Binding, FRotator& OutValue) const
+{
+	if (!ShouldRead(Binding, CDPARAM_Rotator)) return false;
+	OutValue = GetRotator(Binding.Slot);
+	return true;
+}
@@ -0,0 +1,97 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#include "CDCameraFrameContext.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+
+FCDCameraFrameContext FCDCameraFrameContext::Capture(const APlayerController* InPlayerController, const float InDeltaTime,
+                                                     FCDSocketCache* InSocketCache)
+{
+	FCDCameraFrameContext Context;
+	Context.FrameNumber = GFrameCounter;
+	Context.DeltaTime = InDeltaTime;
+	Context.SocketCache = InSocketCache;
+	Context.PlayerController = InPlayerController;
+	if (!InPlayerController) return Context;
+
+	Context.RotationInput = InPlayerController->RotationInput;
+
+	const APawn* ControlledPawn = InPlayerController->GetPawn();
+	if (!ControlledPawn) return Context;
+
+	Context.Pawn = ControlledPawn;
+	Context.bHasPawn = true;
+	Context.PawnLocation = ControlledPawn->GetActorLocation();
+	Context.PawnRotation = ControlledPawn->GetActorQuat();
+	Context.PawnEyeLocation = Context.PawnLocation + FVector(0.0f, 0.0f, ControlledPawn->BaseEyeHeight);
+	Context.PawnVelocity = ControlledPawn->GetVelocity();
+
+	const ACharacter* ControlledCharacter = Cast<ACharacter>(ControlledPawn);
+	if (!ControlledCharacter) return Context;
+
+	Context.Character = ControlledCharacter;
+	Context.PawnMesh = ControlledCharacter->GetMesh();
+	if (const UCharacterMovementComponent* CharacterMovement = ControlledCharacter->GetCharacterMovement())
+	{
+		Context.bHasCharacterMovement = true;
+		Context.bIsMovingOnGround = CharacterMovement->IsMovingOnGround();
+		Context.MovementMode = CharacterMovement->MovementMode;
+	}
+
+	return Context;
+}
+
+FVector FCDCameraFrameContext::GetPawnSocketLocation(const FName SocketName) const
+{
+	if (!PawnMesh) return FVector::ZeroVector;
+	return SocketCache ? SocketCache->GetSocketLocation(*PawnMesh, SocketName) : PawnMesh->GetSocketLocation(SocketName);
+}
+
+FVector FCDSocketCache::GetSocketLocation(const USkeletalMeshComponent& InMesh, const FName SocketName)
+{
+	// Followers of a leader pose don't own their component space transforms, let the mesh resolve the socket
+	if (InMesh.LeaderPoseComponent.IsValid())
+	{
+		return InMesh.GetSocketLocation(SocketName);
+	}
+
+	const USkinnedAsset* InMeshAsset = InMesh.GetSkinnedAsset();
+	if (Mesh.Get() != &InMesh || MeshAsset.Get() != InMeshAsset)
+	{
+		Mesh = &InMesh;
+		MeshAsset = InMeshAsset;
+		Entries.Reset();
+	}
+
+	FEntry* Entry = Entries.FindByPredicate([SocketName](const FEntry& Candidate) { return Candidate.SocketName == SocketName; });
+	if (!Entry)
+	{
+		Entry = &Entries.AddDefaulted_GetRef();
+		Entry->SocketName = SocketName;
+
+		// The name can be either a socket on the mesh or skeleton, or a bone
+		if (const USkeletalMeshSocket* Socket = InMesh.GetSocketByName(SocketName))
+		{
+			Entry->BoneIndex = InMesh.GetBoneIndex(Socket->BoneName);
+			Entry->SocketLocalTransform = Socket->GetSocketLocalTransform();
+		}
+		else
+		{
+			Entry->BoneIndex = InMesh.GetBoneIndex(SocketName);
+		}
+	}
+
+	// Read the pose the animation evaluation has already finished, without updating the component's transform
+	const TArray<FTransform>& ComponentSpaceTransforms = InMesh.GetComponentSpaceTransforms();
+	if (!ComponentSpaceTransforms.IsValidIndex(Entry->BoneIndex))
+	{
+		return InMesh.GetSocketLocation(SocketName);
+	}
+
+	const FVector BoneSpaceLocation = Entry->SocketLocalTransform.GetLocation();
+	const FVector ComponentSpaceLocation = ComponentSpaceTransforms[Entry->BoneIndex].TransformPosition(BoneSpaceLocation);
+	return InMesh.GetComponentTransform().TransformPosition(ComponentSpaceLocation);
+}
@@ -0,0 +1,118 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "CDCameraKernels.h"
+#include "CameraDynamicsFunctionLibrary.h"
+
+FVector CDCameraKernels::StepPositionLag(const FLagParams& Params, const FVector& ViewLocation, const FQuat& ViewRotation,
+                                         const FVector* PawnVelocity, const float DeltaTime, FVector& InOutLaggedPosition,
+                                         FQuat& InOutLastFrameRotation, float& OutInterpSpeed, float& InOutDistanceToTarget)
+{
+	const FVector& CameraPositionTarget = ViewLocation;
+	OutInterpSpeed = Params.InterpSpeedMod;
+
+	/* Find distance between the previous frame's lagged position and the current frame's position target
+	in order to evaluate the interp speed curve */
+	if (Params.InterpSpeedCurve)
+	{
+		const FVector DistanceCalcPosition = Params.AxisInfluence.ProcessAxis(InOutLaggedPosition, CameraPositionTarget);
+		InOutDistanceToTarget = FVector::Distance(InOutLaggedPosition, DistanceCalcPosition);
+		OutInterpSpeed *= EvalCurve(Params.InterpSpeedCurve, InOutDistanceToTarget);
+	}
+
+	// Add the delta rotation to the interp speed, if applicable
+	if (Params.bAddDeltaRotationToInterpSpeed)
+	{
+		float RotInterpSpeedScale = Params.DeltaRotationToInterpSpeedScale;
+		if (Params.DeltaYawVelocityInfluenceCurve && PawnVelocity)
+		{
+			const float Velocity = Params.DeltaYawVelocityAxisInfluence.ProcessAxis(FVector::ZeroVector, *PawnVelocity).Length();
+			RotInterpSpeedScale *= EvalCurve(Params.DeltaYawVelocityInfluenceCurve, Velocity);
+		}
+		const float DeltaRot = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(InOutLastFrameRotation.GetForwardVector() | ViewRotation.GetForwardVector(), -1.0, 1.0)));
+		OutInterpSpeed += DeltaRot * RotInterpSpeedScale;
+	}
+	InOutLastFrameRotation = ViewRotation;
+
+	// If the interp speed is zero, and we don't snap at 0, don't interpolate the camera position
+	if (!(!Params.bZeroValueSnaps && OutInterpSpeed <= 0.0f))
+	{
+		InOutLaggedPosition = FMath::VInterpTo(InOutLaggedPosition, CameraPositionTarget, DeltaTime, OutInterpSpeed);
+	}
+
+	InOutLaggedPosition.X = FMath::Lerp(CameraPositionTarget.X, InOutLaggedPosition.X, Params.AxisInfluence.GetXYInfluence());
+	InOutLaggedPosition.X = FMath::Lerp(CameraPositionTarget.X, InOutLaggedPosition.X, Params.AxisInfluence.GetXYInfluence());
+
+	// Apply the axis influence
+	InOutLaggedPosition = Params.AxisInfluence.ProcessAxis(CameraPositionTarget, InOutLaggedPosition);
+
+	// If we are using max distance, clamp the distance to max distance (if the current distance exceeds max distance)
+	if (Params.bUseMaxDistance && InOutDistanceToTarget > Params.MaxDistanceBeforeSnap)
+	{
+		const FVector FromOrigin = CameraPositionTarget - InOutLaggedPosition;
+		InOutLaggedPosition = CameraPositionTarget + FromOrigin.GetClampedToMaxSize(Params.MaxDistanceBeforeSnap);
+	}
+
+	return InOutLaggedPosition;
+}
+
+float CDCameraKernels::ApplyPitchToFOV(const float FOV, float Pitch, const FCDCurveRef& Curve, const ECameraCurveModType EvaluationType,
+                                       const bool bRemapPitch, const FFloatRange& PitchRange, const FFloatRange& PitchOutRange)
+{
+	if (Pitch > 90.0f)
+	{
+		Pitch = 0;
+	}
+	if (bRemapPitch)
+	{
+		Pitch = FMath::GetMappedRangeValueClamped(PitchRange, PitchOutRange, Pitch);
+	}
+
+	const float EvaluatedCurveValue = EvalCurve(Curve, Pitch);
+
+	switch (EvaluationType)
+	{
+	case ECM_Absolute:			return EvaluatedCurveValue;
+	case ECM_Additive:			return FOV + EvaluatedCurveValue;
+	case ECM_Multiplicative:	return FOV * EvaluatedCurveValue;
+	default:					return FOV;
+	}
+}
+
+void CDCameraKernels::StepDynamicZ(const FDynamicZParams& Params, const bool bGrounded, const float DeltaTime,
+                                   FVector& InOutViewLocation, FVector& InOutLastGroundedPosition,
+                                   FVector& InOutCurrentPosition, bool& bInOutShouldDirectInterpZ)
+{
+	// If we are grounded
+	if (bGrounded)
+	{
+		// Check if the camera is already at target
+		if (bInOutShouldDirectInterpZ)
+		{
+			if (FMath::IsNearlyEqual(InOutCurrentPosition.Z, InOutViewLocation.Z, 0.1f))
+			{
+				bInOutShouldDirectInterpZ = false;
+			}
+			else
+			{
+				const float DirectInterp = EvalCurve(Params.ReturnSpeed, FMath::Abs(InOutCurrentPosition.Z - InOutViewLocation.Z));
+				InOutViewLocation.Z = UCameraDynamicsFunctionLibrary::CameraFInterp(
+					InOutCurrentPosition.Z, InOutViewLocation.Z, DeltaTime, DirectInterp, false, -1.0f, Params.SnapThreshold);
+			}
+		}
+		InOutCurrentPosition = InOutViewLocation;
+		InOutLastGroundedPosition = InOutViewLocation;
+		return;
+	}
+
+	// Evaluate the interp speed if we're not grounded
+	InOutLastGroundedPosition.X = InOutViewLocation.X;
+	InOutLastGroundedPosition.Y = InOutViewLocation.Y;
+
+	const float DistanceFromLastGrounded = InOutViewLocation.Z - InOutLastGroundedPosition.Z;
+	const float ZInterp = EvalCurve(Params.AirborneInterpSpeed, DistanceFromLastGrounded);
+	InOutViewLocation.Z = UCameraDynamicsFunctionLibrary::CameraFInterp(InOutCurrentPosition.Z, InOutViewLocation.Z, DeltaTime,
+	                                                                    ZInterp, false, 0.0f, Params.SnapThreshold);
+
+	InOutCurrentPosition = InOutViewLocation;
+}
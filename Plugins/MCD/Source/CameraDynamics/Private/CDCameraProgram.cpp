@@ -0,0 +1,420 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "CDCameraProgram.h"
+#include "CDCameraQuerySubsystem.h"
+#include "CDCameraStack.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Modifiers/CDCameraModifier_FOV_Adjust.h"
+#include "Modifiers/CDCameraModifier_FOV_PitchMod.h"
+#include "Modifiers/CDCameraModifier_Position_Base.h"
+#include "Modifiers/CDCameraModifier_Position_Distance.h"
+#include "Modifiers/CDCameraModifier_Position_DynamicZ.h"
+#include "Modifiers/CDCameraModifier_Position_Lag.h"
+#include "Modifiers/CDCameraModifier_Position_Offset.h"
+
+namespace
+{
+	/** Find the op code for a modifier class, returns false if the class can't be compiled */
+	bool GetOpCodeForClass(const UClass* ModifierClass, ECDCameraOpCode& OutOpCode)
+	{
+		if (ModifierClass == UCDCameraModifier_Position_Base::StaticClass())		OutOpCode = ECDCameraOpCode::PositionBase;
+		else if (ModifierClass == UCDCameraModifier_Position_Offset::StaticClass())	OutOpCode = ECDCameraOpCode::PositionOffset;
+		else if (ModifierClass == UCDCameraModifier_Position_Distance::StaticClass())	OutOpCode = ECDCameraOpCode::PositionDistance;
+		else if (ModifierClass == UCDCameraModifier_Position_Lag::StaticClass())		OutOpCode = ECDCameraOpCode::PositionLag;
+		else if (ModifierClass == UCDCameraModifier_Position_DynamicZ::StaticClass())	OutOpCode = ECDCameraOpCode::PositionDynamicZ;
+		else if (ModifierClass == UCDCameraModifier_FOV_Adjust::StaticClass())		OutOpCode = ECDCameraOpCode::FOVAdjust;
+		else if (ModifierClass == UCDCameraModifier_FOV_PitchMod::StaticClass())		OutOpCode = ECDCameraOpCode::FOVPitchMod;
+		else if (ModifierClass == UCDCameraModifier_Rotation_Override::StaticClass())	OutOpCode = ECDCameraOpCode::RotationOverride;
+		else if (ModifierClass == UCDCameraModifier_Sweep_Basic::StaticClass())		OutOpCode = ECDCameraOpCode::SweepBasic;
+		else return false;
+		return true;
+	}
+
+	/** Modifiers can only share a run if they react to view target changes in the same way */
+	bool ShareViewTargetSettings(const UCDCameraModifierInstanced* A, const UCDCameraModifierInstanced* B)
+	{
+		return A->bBlendOutForViewTargetWithMatchingTag == B->bBlendOutForViewTargetWithMatchingTag
+			&& A->ViewTargetBlendOutTag == B->ViewTargetBlendOutTag
+			&& A->bWatchForViewTargetChange == B->bWatchForViewTargetChange;
+	}
+}
+
+/*
+ * Compilation
+ */
+
+bool FCDCameraProgram::CanCompile(const UCDCameraModifierInstanced* Modifier)
+{
+	if (!IsValid(Modifier)) return false;
+
+	// Only exact native classes, Blueprint subclasses may implement the Blueprint events
+	ECDCameraOpCode OpCode;
+	if (!GetOpCodeForClass(Modifier->GetClass(), OpCode)) return false;
+
+	// Custom priorities can move the modifier away from the rest of its run
+	if (Modifier->bUseCustomPriority) return false;
+
+	// Programs evaluate every frame, reduced rate modifiers keep their own timing as normal modifiers
+	if (Modifier->IsReducedRate()) return false;
+
+	// Compiled parameters are fixed, bound inputs need the modifier object
+	if (Modifier->HasParameterBindings()) return false;
+
+	// Actors and components can't be referenced from the camera data, so only fixed rotation overrides are compiled
+	if (OpCode == ECDCameraOpCode::RotationOverride)
+	{
+		const ECDRotationOverrideType OverrideType = CastChecked<UCDCameraModifier_Rotation_Override>(Modifier)->RotationOverrideType;
+		return OverrideType == CAMROT_None || OverrideType == CAMROT_Absolute || OverrideType == CAMROT_LookAtLocation;
+	}
+
+	// Async and cached sweeps keep state across frames, which programs don't have for sweeps
+	if (OpCode == ECDCameraOpCode::SweepBasic)
+	{
+		const UCDCameraModifier_Sweep_Basic* Sweep = CastChecked<UCDCameraModifier_Sweep_Basic>(Modifier);
+		return !Sweep->bUseAsyncSweep && !Sweep->bUseSweepCache;
+	}
+	return true;
+}
+
+TSharedRef<const FCDCameraProgram> FCDCameraProgram::Compile(const UCDCameraData& CameraData)
+{
+	TSharedRef<FCDCameraProgram> Program = MakeShared<FCDCameraProgram>();
+	const TArray<TObjectPtr<UCDCameraModifierInstanced>>& Modifiers = CameraData.CameraModifiers;
+	Program->RunStartingAtSource.Init(INDEX_NONE, Modifiers.Num());
+	Program->CompiledSources.Init(false, Modifiers.Num());
+
+	const UCDCameraModifierInstanced* PreviousModifier = nullptr;
+	for (int32 SourceIndex = 0; SourceIndex < Modifiers.Num() && SourceIndex <= MAX_uint16; ++SourceIndex)
+	{
+		const UCDCameraModifierInstanced* Modifier = Modifiers[SourceIndex];
+		if (!CanCompile(Modifier))
+		{
+			PreviousModifier = nullptr;	// Anything that isn't compiled ends the current run
+			continue;
+		}
+
+		// Start a new run if needed
+		if (!PreviousModifier || !ShareViewTargetSettings(PreviousModifier, Modifier))
+		{
+			FCDCameraProgramRun& NewRun = Program->Runs.AddDefaulted_GetRef();
+			NewRun.FirstOp = Program->Ops.Num();
+			Program->RunStartingAtSource[SourceIndex] = Program->Runs.Num() - 1;
+		}
+		FCDCameraProgramRun& Run = Program->Runs.Last();
+
+		ECDCameraOpCode OpCode;
+		GetOpCodeForClass(Modifier->GetClass(), OpCode);
+
+		// Copy the parameters into the parameter block for this op code
+		int32 ParamIndex = INDEX_NONE;
+		switch (OpCode)
+		{
+		case ECDCameraOpCode::PositionBase:
+		{
+			const UCDCameraModifier_Position_Base* Base = CastChecked<UCDCameraModifier_Position_Base>(Modifier);
+			ParamIndex = Program->PositionBaseParams.Add({Base->CameraBasePosition, Base->AxisInfluence});
+			break;
+		}
+		case ECDCameraOpCode::PositionOffset:
+			ParamIndex = Program->PositionOffsetParams.Add(CastChecked<UCDCameraModifier_Position_Offset>(Modifier)->CameraOffsetPosition);
+			break;
+		case ECDCameraOpCode::PositionDistance:
+		{
+			const UCDCameraModifier_Position_Distance* Distance = CastChecked<UCDCameraModifier_Position_Distance>(Modifier);
+			ParamIndex = Program->PositionDistanceParams.Add({Distance->TargetDistance, Distance->bSmoothDistanceChanges, Distance->ChangeSmoothing});
+			break;
+		}
+		case ECDCameraOpCode::PositionLag:
+			ParamIndex = Program->PositionLagParams.Add(CastChecked<UCDCameraModifier_Position_Lag>(Modifier)->MakeLagParams());
+			break;
+		case ECDCameraOpCode::PositionDynamicZ:
+			ParamIndex = Program->PositionDynamicZParams.Add(CastChecked<UCDCameraModifier_Position_DynamicZ>(Modifier)->MakeDynamicZParams());
+			break;
+		case ECDCameraOpCode::FOVAdjust:
+		{
+			const UCDCameraModifier_FOV_Adjust* FOVAdjust = CastChecked<UCDCameraModifier_FOV_Adjust>(Modifier);
+			ParamIndex = Program->FOVAdjustParams.Add({FOVAdjust->DefaultFOVChange, FOVAdjust->bUseSmoothing,
+			                                           FOVAdjust->SmoothingSpeed, FOVAdjust->ModificationType});
+			break;
+		}
+		case ECDCameraOpCode::FOVPitchMod:
+		{
+			const UCDCameraModifier_FOV_PitchMod* PitchMod = CastChecked<UCDCameraModifier_FOV_PitchMod>(Modifier);
+			ParamIndex = Program->FOVPitchModParams.Add({PitchMod->GetBakedCurve(PitchMod->PitchToFOVData.Curve),
+			                                             PitchMod->PitchToFOVData.CurveEvaluationType, PitchMod->bRemapPitch,
+			                                             PitchMod->PitchRange, PitchMod->PitchOutRange});
+			break;
+		}
+		case ECDCameraOpCode::RotationOverride:
+		{
+			const UCDCameraModifier_Rotation_Override* Override = CastChecked<UCDCameraModifier_Rotation_Override>(Modifier);
+			ParamIndex = Program->RotationOverrideParams.Add({Override->RotationOverrideType, Override->RotationOverride,
+			                                                  Override->LookAtLocation});
+			break;
+		}
+		case ECDCameraOpCode::SweepBasic:
+			ParamIndex = Program->SweepBasicParams.Add(CastChecked<UCDCameraModifier_Sweep_Basic>(Modifier)->CameraTraceData);
+			break;
+		default:
+			break;
+		}
+
+		const int32 OpCodeIndex = static_cast<int32>(OpCode);
+		if (Run.NumParams[OpCodeIndex] == 0) Run.FirstParam[OpCodeIndex] = ParamIndex;
+		Run.NumParams[OpCodeIndex]++;
+		Run.NumOps++;
+
+		Program->Ops.Add({OpCode, static_cast<uint16>(ParamIndex), static_cast<uint16>(SourceIndex)});
+		Program->Blends.Add({
+			Modifier->AlphaInTime, Modifier->AlphaOutTime,
+			Modifier->bUseCustomBlendIn ? Modifier->GetBakedCurve(Modifier->CustomBlendIn) : FCDCurveRef(),
+			Modifier->bUseCustomBlendOut ? Modifier->GetBakedCurve(Modifier->CustomBlendOut) : FCDCurveRef()
+		});
+		Program->CompiledSources[SourceIndex] = true;
+		PreviousModifier = Modifier;
+	}
+
+	return Program;
+}
+
+/*
+ * Evaluation
+ */
+
+void FCDCameraProgram::InitializeState(const int32 RunIndex, FCDCameraProgramState& OutState, const FVector& CameraLocation,
+                                       const FQuat& CameraRotation) const
+{
+	const FCDCameraProgramRun& Run = Runs[RunIndex];
+	OutState.Alpha.Init(0.0f, Run.NumOps);
+
+	const int32 DistanceIndex = static_cast<int32>(ECDCameraOpCode::PositionDistance);
+	OutState.Distance.SetNumUninitialized(Run.NumParams[DistanceIndex]);
+	for (int32 Index = 0; Index < OutState.Distance.Num(); ++Index)
+	{
+		OutState.Distance[Index] = PositionDistanceParams[Run.FirstParam[DistanceIndex] + Index].TargetDistance;
+	}
+
+	const int32 FOVIndex = static_cast<int32>(ECDCameraOpCode::FOVAdjust);
+	OutState.FOVChange.SetNumUninitialized(Run.NumParams[FOVIndex]);
+	for (int32 Index = 0; Index < OutState.FOVChange.Num(); ++Index)
+	{
+		OutState.FOVChange[Index] = FOVAdjustParams[Run.FirstParam[FOVIndex] + Index].DefaultFOVChange;
+	}
+
+	// Same starting values as the modifiers set in AddedToCamera
+	FCDCameraProgramState::FLagState LagState;
+	LagState.CameraPositionTarget = CameraLocation;
+	LagState.LaggedCameraPosition = CameraLocation;
+	LagState.LastFrameRotation = CameraRotation;
+	OutState.Lag.Init(LagState, Run.NumParams[static_cast<int32>(ECDCameraOpCode::PositionLag)]);
+
+	FCDCameraProgramState::FDynamicZState DynamicZState;
+	DynamicZState.LastGroundedPosition = CameraLocation;
+	OutState.DynamicZ.Init(DynamicZState, Run.NumParams[static_cast<int32>(ECDCameraOpCode::PositionDynamicZ)]);
+}
+
+void FCDCameraProgram::UpdateAlpha(const int32 RunIndex, FCDCameraProgramState& State, const float TargetAlpha,
+                                   const float CustomBlendTime, const float DeltaTime) const
+{
+	const FCDCameraProgramRun& Run = Runs[RunIndex];
+	for (int32 Index = 0; Index < Run.NumOps; ++Index)
+	{
+		const FCDCameraOpBlend& Blend = Blends[Run.FirstOp + Index];
+		const float BlendTime = CDCameraKernels::GetBlendTime(TargetAlpha, Blend.AlphaInTime, Blend.AlphaOutTime, CustomBlendTime);
+		State.Alpha[Index] = CDCameraKernels::StepAlpha(State.Alpha[Index], TargetAlpha, BlendTime, DeltaTime);
+	}
+}
+
+float FCDCameraProgram::GetBlendAlpha(const int32 OpIndex, const FCDCameraProgramState& State, const int32 RunIndex,
+                                      const bool bBlendIn) const
+{
+	const FCDCameraOpBlend& Blend = Blends[Runs[RunIndex].FirstOp + OpIndex];
+	return CDCameraKernels::ResolveCustomBlendAlpha(State.Alpha[OpIndex], bBlendIn, Blend.AlphaInTime, Blend.AlphaOutTime,
+	                                                Blend.CustomBlendIn, Blend.CustomBlendOut);
+}
+
+void FCDCameraProgram::Execute(const int32 RunIndex, FCDCameraProgramState& State, const FCDCameraProgramContext& Context,
+                               FCDCameraPose& InOutPose) const
+{
+	const FCDCameraProgramRun& Run = Runs[RunIndex];
+	for (int32 Index = 0; Index < Run.NumOps; ++Index)
+	{
+		const FCDCameraOp& Op = Ops[Run.FirstOp + Index];
+		const FVector ViewLocation = InOutPose.Location;
+		const float ViewFOV = InOutPose.FOV;
+
+		// The basic sweep replaces the whole modification and is never blended
+		if (Op.OpCode == ECDCameraOpCode::SweepBasic)
+		{
+			ExecuteOp(Run, Op, State, Context, InOutPose.Location, InOutPose.FOV, InOutPose.Rotation);
+			continue;
+		}
+
+		const float A = GetBlendAlpha(Index, State, RunIndex, Context.bBlendIn);
+		if (A == 0.0f) continue;
+
+		ExecuteOp(Run, Op, State, Context, InOutPose.Location, InOutPose.FOV, InOutPose.Rotation);
+
+		// Early continue if this op is fully active
+		if (A == 1.0f) continue;
+
+		// None of the compiled ops change the rotation here, so only location and FOV need blending
+		InOutPose.Location = FMath::Lerp(ViewLocation, InOutPose.Location, A);
+		InOutPose.FOV = FMath::Lerp(ViewFOV, InOutPose.FOV, A);
+	}
+}
+
+void FCDCameraProgram::ExecuteOp(const FCDCameraProgramRun& Run, const FCDCameraOp& Op, FCDCameraProgramState& State,
+                                 const FCDCameraProgramContext& Context, FVector& InOutLocation, float& InOutFOV,
+                                 const FQuat& ViewRotation) const
+{
+	check(Context.Frame);
+	const FCDCameraFrameContext& Frame = *Context.Frame;
+	const int32 StateIndex = GetStateIndex(Run, Op);
+	switch (Op.OpCode)
+	{
+	case ECDCameraOpCode::PositionBase:
+	{
+		if (!Frame.bHasPawn) return;
+		const FCDPositionBaseParams& Params = PositionBaseParams[Op.ParamIndex];
+		const FVector PotentialViewLocation = Params.CameraBasePosition.FindSourcePosition(Frame);
+		InOutLocation = Params.AxisInfluence.ProcessAxis(InOutLocation, PotentialViewLocation);
+		return;
+	}
+	case ECDCameraOpCode::PositionOffset:
+		InOutLocation = PositionOffsetParams[Op.ParamIndex].GetOffsetPosition(InOutLocation, ViewRotation);
+		return;
+	case ECDCameraOpCode::PositionDistance:
+	{
+		const FCDPositionDistanceParams& Params = PositionDistanceParams[Op.ParamIndex];
+		float& Distance = State.Distance[StateIndex];
+		Distance = CDCameraKernels::StepSmoothedValue(Distance, Params.TargetDistance, Params.bSmoothDistanceChanges,
+		                                              Params.ChangeSmoothing, Context.DeltaTime);
+		InOutLocation = CDCameraKernels::ApplyForwardDistance(InOutLocation, ViewRotation, Distance);
+		return;
+	}
+	case ECDCameraOpCode::PositionLag:
+	{
+		const CDCameraKernels::FLagParams& Params = PositionLagParams[Op.ParamIndex];
+		FCDCameraProgramState::FLagState& Lag = State.Lag[StateIndex];
+		Lag.CameraPositionTarget = InOutLocation;
+		InOutLocation = CDCameraKernels::StepPositionLag(Params, InOutLocation, ViewRotation, Frame.GetPawnVelocity(),
+		                                                 Context.DeltaTime, Lag.LaggedCameraPosition, Lag.LastFrameRotation,
+		                                                 Lag.InterpSpeed, Lag.DistanceToTarget);
+		return;
+	}
+	case ECDCameraOpCode::PositionDynamicZ:
+	{
+		if (!Frame.bHasCharacterMovement) return;
+
+		// The modifier listens for the landed event, the program checks for the grounded state changing instead
+		FCDCameraProgramState::FDynamicZState& DynamicZ = State.DynamicZ[StateIndex];
+		const bool bGrounded = Frame.bIsMovingOnGround;
+		if (bGrounded && !DynamicZ.bWasGrounded) DynamicZ.bShouldDirectInterpZ = true;
+		DynamicZ.bWasGrounded = bGrounded;
+
+		CDCameraKernels::StepDynamicZ(PositionDynamicZParams[Op.ParamIndex], bGrounded, Context.DeltaTime, InOutLocation,
+		                              DynamicZ.LastGroundedPosition, DynamicZ.CurrentPosition, DynamicZ.bShouldDirectInterpZ);
+		return;
+	}
+	case ECDCameraOpCode::FOVAdjust:
+	{
+		const FCDFOVAdjustParams& Params = FOVAdjustParams[Op.ParamIndex];
+		float& FOVChange = State.FOVChange[StateIndex];
+		FOVChange = CDCameraKernels::StepSmoothedValue(FOVChange, Params.DefaultFOVChange, Params.bUseSmoothing,
+		                                               Params.SmoothingSpeed, Context.DeltaTime);
+		InOutFOV = CDCameraKernels::ApplyFOVChange(InOutFOV, FOVChange, Params.ModificationType);
+		return;
+	}
+	case ECDCameraOpCode::FOVPitchMod:
+	{
+		const FCDFOVPitchModParams& Params = FOVPitchModParams[Op.ParamIndex];
+		InOutFOV = CDCameraKernels::ApplyPitchToFOV(InOutFOV, CDCameraKernels::GetViewPitch(ViewRotation), Params.PitchToFOVCurve, Params.CurveEvaluationType,
+		                                            Params.bRemapPitch, Params.PitchRange, Params.PitchOutRange);
+		return;
+	}
+	case ECDCameraOpCode::SweepBasic:
+	{
+		UCDCameraQuerySubsystem* Queries = Context.World ? Context.World->GetSubsystem<UCDCameraQuerySubsystem>() : nullptr;
+		if (!Queries) return;
+		const FCameraTraceData& Params = SweepBasicParams[Op.ParamIndex];
+
+		FCDCameraQuery Query;
+		Query.Start = Params.TraceStartPoint.FindSourcePosition(Frame);
+		Query.End = InOutLocation;
+		Query.Radius = Params.TraceRadius;
+		Query.Channel = Params.TraceChannel;
+		Query.IgnoredActor = Frame.Pawn;
+		InOutLocation = Queries->Sweep(Query).GetLocation(Query.Start, Query.End);
+		return;
+	}
+	default:
+		// Rotation overrides only process view rotation
+		return;
+	}
+}
+
+bool FCDCameraProgram::ExecuteViewRotation(const int32 RunIndex, const FCDCameraProgramState& State,
+                                           const FCDCameraProgramContext& Context, FRotator& InOutViewRotation,
+                                           FRotator& InOutDeltaRot) const
+{
+	const FCDCameraProgramRun& Run = Runs[RunIndex];
+	for (int32 Index = 0; Index < Run.NumOps; ++Index)
+	{
+		const FCDCameraOp& Op = Ops[Run.FirstOp + Index];
+		if (Op.OpCode != ECDCameraOpCode::RotationOverride) continue;
+
+		const float A = GetBlendAlpha(Index, State, RunIndex, Context.bBlendIn);
+		if (A == 0.0f) continue;
+
+		const FCDRotationOverrideParams& Params = RotationOverrideParams[Op.ParamIndex];
+		FRotator TargetRotation;
+		switch (Params.RotationOverrideType)
+		{
+		case CAMROT_Absolute:
+			TargetRotation = Params.RotationOverride;
+			break;
+		case CAMROT_LookAtLocation:
+			TargetRotation = (Params.LookAtLocation - Context.CameraLocation).Rotation();
+			break;
+		default:
+			continue;
+		}
+
+		// If the rotation values didn't change, don't change them. This is to prevent the rotation from snapping back.
+		if (TargetRotation == InOutViewRotation && InOutDeltaRot == FRotator::ZeroRotator) continue;
+
+		if (A == 1.0f)
+		{
+			InOutViewRotation = TargetRotation;
+			InOutDeltaRot = FRotator::ZeroRotator;
+			continue;
+		}
+
+		// Interpolate the new values with the current values based on the alpha of this op
+		InOutViewRotation = FQuat::Slerp(InOutViewRotation.Quaternion(), TargetRotation.Quaternion(), A).Rotator();
+		InOutDeltaRot = FQuat::Slerp(InOutDeltaRot.Quaternion(), FQuat::Identity, A).Rotator();
+	}
+
+	// Rotation overrides never stop subsequent modifiers from processing view rotation
+	return false;
+}
+
+const TCHAR* FCDCameraProgram::GetOpCodeName(const ECDCameraOpCode OpCode)
+{
+	switch (OpCode)
+	{
+	case ECDCameraOpCode::PositionBase:		return TEXT("Base Position");
+	case ECDCameraOpCode::PositionOffset:	return TEXT("Position Offset");
+	case ECDCameraOpCode::PositionDistance:	return TEXT("Position Distance");
+	case ECDCameraOpCode::PositionLag:		return TEXT("Position Lag");
+	case ECDCameraOpCode::PositionDynamicZ:	return TEXT("Dynamic Z Position");
+	case ECDCameraOpCode::FOVAdjust:		return TEXT("FOV Adjust");
+	case ECDCameraOpCode::FOVPitchMod:		return TEXT("Pitch Driven FOV");
+	case ECDCameraOpCode::RotationOverride:	return TEXT("Rotation Override");
+	case ECDCameraOpCode::SweepBasic:		return TEXT("Basic Collision Trace");
+	default:								return TEXT("Unknown");
+	}
+}
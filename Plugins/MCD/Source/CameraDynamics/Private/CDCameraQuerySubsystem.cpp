@@ -0,0 +1,117 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "CDCameraQuerySubsystem.h"
+#include "CoreGlobals.h"
+#include "Engine/HitResult.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Query Sweep"), STAT_Camera_QuerySweep, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Queries Shared"), STAT_Camera_QueriesShared, STATGROUP_Game);
+
+bool UCDCameraQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::GamePreview;
+}
+
+void UCDCameraQuerySubsystem::BeginFrameIfNeeded()
+{
+	if (CurrentFrame == GFrameCounter) return;
+	CurrentFrame = GFrameCounter;
+
+	SweepResults.Reset();
+	AsyncSweeps.Reset();
+
+	// Drop the params of actors that have been destroyed
+	for (auto It = QueryParams.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+FCDCameraQueryResult UCDCameraQuerySubsystem::Sweep(const FCDCameraQuery& Query)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Camera_QuerySweep);
+
+	BeginFrameIfNeeded();
+	QueriesRequested++;
+
+	if (const FCDCameraQueryResult* SharedResult = SweepResults.Find(Query))
+	{
+		INC_DWORD_STAT(STAT_Camera_QueriesShared);
+		return *SharedResult;
+	}
+
+	FCDCameraQueryResult Result;
+	FHitResult Hit;
+	if (GetWorld()->SweepSingleByChannel(Hit, Query.Start, Query.End, FQuat::Identity, Query.Channel,
+	                                     FCollisionShape::MakeSphere(Query.Radius), GetQueryParams(Query.IgnoredActor)))
+	{
+		Result.bHit = true;
+		Result.Fraction = Hit.Time;
+	}
+	QueriesExecuted++;
+
+	SweepResults.Add(Query, Result);
+	return Result;
+}
+
+FTraceHandle UCDCameraQuerySubsystem::RequestAsyncSweep(const FCDCameraQuery& Query)
+{
+	BeginFrameIfNeeded();
+	QueriesRequested++;
+
+	if (const FTraceHandle* SharedHandle = AsyncSweeps.Find(Query))
+	{
+		INC_DWORD_STAT(STAT_Camera_QueriesShared);
+		return *SharedHandle;
+	}
+
+	const FTraceHandle Handle = GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, Query.Start, Query.End, FQuat::Identity,
+	                                                            Query.Channel, FCollisionShape::MakeSphere(Query.Radius),
+	                                                            GetQueryParams(Query.IgnoredActor));
+	QueriesExecuted++;
+
+	AsyncSweeps.Add(Query, Handle);
+	return Handle;
+}
+
+bool UCDCameraQuerySubsystem::GetAsyncSweepResult(const FTraceHandle& Handle, FCDCameraQueryResult& OutResult) const
+{
+	FTraceDatum TraceDatum;
+	if (!Handle.IsValid() || !GetWorld()->QueryTraceData(Handle, TraceDatum))
+	{
+		return false;
+	}
+
+	const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+	OutResult.bHit = BlockingHit != nullptr;
+	OutResult.Fraction = BlockingHit ? BlockingHit->Time : 1.0f;
+	return true;
+}
+
+const FCollisionQueryParams& UCDCameraQuerySubsystem::GetQueryParams(const AActor* IgnoredActor)
+{
+	const TObjectKey<AActor> Key(IgnoredActor);
+	if (const FCollisionQueryParams* Params = QueryParams.Find(Key))
+	{
+		return *Params;
+	}
+	return QueryParams.Add(Key, FCollisionQueryParams(SCENE_QUERY_STAT(CameraDynamicsSweep), false, IgnoredActor));
+}
+
+void UCDCameraQuerySubsystem::GetQueryStats(int32& Requested, int32& Executed) const
+{
+	Requested = QueriesRequested;
+	Executed = QueriesExecuted;
+}
+
+void UCDCameraQuerySubsystem::ResetQueryStats()
+{
+	QueriesRequested = 0;
+	QueriesExecuted = 0;
+}
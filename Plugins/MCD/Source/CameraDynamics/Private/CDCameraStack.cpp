@@ -2,8 +2,45 @@
 
 
 #include "CDCameraStack.h"
+#include "CDCameraProgram.h"
+#include "Modifiers/CDCameraModifier_Instanced.h"
 
 UCDCameraData::UCDCameraData()
 {
-	
+	bCompileCameraProgram = false;
 }
+
+TSharedPtr<const FCDCameraProgram> UCDCameraData::GetCameraProgram()
+{
+	if (!bCompileCameraProgram) return nullptr;
+	if (!CameraProgram.IsValid()) CameraProgram = FCDCameraProgram::Compile(*this);
+	return CameraProgram;
+}
+
+void UCDCameraData::PostLoad()
+{
+	Super::PostLoad();
+
+	// Runtime modifiers share these bakes, so each curve is only baked once
+	for (UCDCameraModifierInstanced* Modifier : CameraModifiers)
+	{
+		if (Modifier) Modifier->RefreshBakedCurves();
+	}
+
+	// Compile on load, so the first time this camera data is added doesn't have to
+	if (bCompileCameraProgram) CameraProgram = FCDCameraProgram::Compile(*this);
+}
+
+#if WITH_EDITOR
+void UCDCameraData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	CameraProgram.Reset();	// Recompiled the next time the camera data is added
+}
+
+void UCDCameraData::PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeChainProperty(PropertyChangedEvent);
+	CameraProgram.Reset();
+}
+#endif
@@ -0,0 +1,53 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "CDCameraUpdateSubsystem.h"
+#include "CDPlayerCameraManager.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera PreUpdateCameras"), STAT_Camera_PreUpdateCameras, STATGROUP_Game);
+
+void UCDCameraUpdateSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Tickable objects tick after the tick groups and before the player controllers update their cameras
+	PreUpdateCameras(DeltaTime);
+}
+
+TStatId UCDCameraUpdateSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCDCameraUpdateSubsystem, STATGROUP_Tickables);
+}
+
+bool UCDCameraUpdateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCDCameraUpdateSubsystem::PreUpdateCameras(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Camera_PreUpdateCameras);
+
+	CameraManagers.Reset();
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (!PlayerController || !PlayerController->IsLocalController()) continue;
+
+		ACDPlayerCameraManager* CameraManager = Cast<ACDPlayerCameraManager>(PlayerController->PlayerCameraManager);
+		if (CameraManager && CameraManager->WantsParallelPreUpdate())
+		{
+			// Reading the world and the modifiers happens here on the game thread, the pre-update only uses the snapshot
+			CameraManager->CapturePreUpdate(DeltaTime);
+			CameraManagers.Add(CameraManager);
+		}
+	}
+
+	ParallelFor(CameraManagers.Num(), [this](const int32 Index)
+	{
+		CameraManagers[Index]->PreUpdateCamera();
+	});
+}
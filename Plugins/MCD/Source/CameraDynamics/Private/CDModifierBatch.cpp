@@ -0,0 +1,524 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "CDModifierBatch.h"
+#include "Modifiers/CDCameraModifier_FOV_Adjust.h"
+#include "Modifiers/CDCameraModifier_Position_Distance.h"
+#include "Modifiers/CDCameraModifier_Position_Lag.h"
+#include "Modifiers/CDCameraModifier_Position_Offset.h"
+
+namespace
+{
+	/** Remove the same slot from every column, keeping them aligned */
+	template <typename... ColumnTypes>
+	void RemoveColumnsAtSwap(const int32 Slot, ColumnTypes&... Columns)
+	{
+		(Columns.RemoveAtSwap(Slot), ...);
+	}
+}
+
+/*
+ * Blend columns
+ */
+
+void FCDBatchBlendColumns::Add(UCDCameraModifierInstanced* Modifier)
+{
+	Alpha.Add(Modifier->Alpha);
+	TargetAlpha.AddZeroed();
+	AlphaInTime.AddZeroed();
+	AlphaOutTime.AddZeroed();
+	CustomBlendTime.AddZeroed();
+	CustomBlendIn.AddDefaulted();
+	CustomBlendOut.AddDefaulted();
+	bPendingDisable.Add(false);
+	bDisabled.Add(false);
+	BlendedAlpha.Add(Modifier->Alpha);
+	AlphaBeforeAdvance.Add(Modifier->Alpha);
+	Refresh(Alpha.Num() - 1, Modifier);
+}
+
+void FCDBatchBlendColumns::Refresh(const int32 Slot, UCDCameraModifierInstanced* Modifier)
+{
+	TargetAlpha[Slot] = Modifier->GetTargetAlpha();
+	AlphaInTime[Slot] = Modifier->AlphaInTime;
+	AlphaOutTime[Slot] = Modifier->AlphaOutTime;
+	CustomBlendTime[Slot] = Modifier->CustomTargetBlendTime;
+	CustomBlendIn[Slot] = Modifier->bUseCustomBlendIn ? Modifier->GetBakedCurve(Modifier->CustomBlendIn) : FCDCurveRef();
+	CustomBlendOut[Slot] = Modifier->bUseCustomBlendOut ? Modifier->GetBakedCurve(Modifier->CustomBlendOut) : FCDCurveRef();
+	bPendingDisable[Slot] = Modifier->bPendingDisable;
+	bDisabled[Slot] = Modifier->IsDisabled();
+}
+
+void FCDBatchBlendColumns::RemoveAtSwap(const int32 Slot)
+{
+	RemoveColumnsAtSwap(Slot, Alpha, TargetAlpha, AlphaInTime, AlphaOutTime, CustomBlendTime, CustomBlendIn,
+	                    CustomBlendOut, bPendingDisable, bDisabled, BlendedAlpha, AlphaBeforeAdvance);
+}
+
+void FCDBatchBlendColumns::Reset()
+{
+	Alpha.Reset();
+	TargetAlpha.Reset();
+	AlphaInTime.Reset();
+	AlphaOutTime.Reset();
+	CustomBlendTime.Reset();
+	CustomBlendIn.Reset();
+	CustomBlendOut.Reset();
+	bPendingDisable.Reset();
+	bDisabled.Reset();
+	BlendedAlpha.Reset();
+	AlphaBeforeAdvance.Reset();
+}
+
+void FCDBatchBlendColumns::Step(const float DeltaTime)
+{
+	AlphaBeforeAdvance = Alpha;
+	for (int32 Slot = 0; Slot < Alpha.Num(); ++Slot)
+	{
+		if (bDisabled[Slot]) continue;	// Disabled modifiers are skipped by the camera manager, so their alpha doesn't update
+
+		const float BlendTime = CDCameraKernels::GetBlendTime(TargetAlpha[Slot], AlphaInTime[Slot], AlphaOutTime[Slot], CustomBlendTime[Slot]);
+		Alpha[Slot] = CDCameraKernels::StepAlpha(Alpha[Slot], TargetAlpha[Slot], BlendTime, DeltaTime);
+		BlendedAlpha[Slot] = CDCameraKernels::ResolveCustomBlendAlpha(Alpha[Slot], !bPendingDisable[Slot], AlphaInTime[Slot],
+		                                                              AlphaOutTime[Slot], CustomBlendIn[Slot], CustomBlendOut[Slot]);
+	}
+}
+
+void FCDBatchBlendColumns::RewindSlot(const int32 Slot)
+{
+	Alpha[Slot] = AlphaBeforeAdvance[Slot];
+	BlendedAlpha[Slot] = CDCameraKernels::ResolveCustomBlendAlpha(Alpha[Slot], !bPendingDisable[Slot], AlphaInTime[Slot],
+	                                                              AlphaOutTime[Slot], CustomBlendIn[Slot], CustomBlendOut[Slot]);
+}
+
+/*
+ * Registration
+ */
+
+bool FCDModifierBatch::CanBatch(const UCameraModifier* Modifier)
+{
+	if (!IsValid(Modifier)) return false;
+
+	// Only exact native classes, Blueprint subclasses may implement the Blueprint events
+	const UClass* ModifierClass = Modifier->GetClass();
+	const bool bBatchedClass = ModifierClass == UCDCameraModifier_Position_Offset::StaticClass()
+		|| ModifierClass == UCDCameraModifier_Position_Distance::StaticClass()
+		|| ModifierClass == UCDCameraModifier_FOV_Adjust::StaticClass()
+		|| ModifierClass == UCDCameraModifier_Position_Lag::StaticClass();
+
+	// The batch evaluates every frame, reduced rate modifiers keep their own timing on the object path
+	return bBatchedClass && !CastChecked<UCDCameraModifierInstanced>(Modifier)->IsReducedRate();
+}
+
+FCDBatchHandle FCDModifierBatch::Register(UCameraModifier* Modifier)
+{
+	if (!CanBatch(Modifier)) return FCDBatchHandle();
+	if (const FCDBatchHandle* ExistingHandle = Handles.Find(Modifier)) return *ExistingHandle;
+
+	FCDBatchHandle Handle;
+	const UClass* ModifierClass = Modifier->GetClass();
+	if (ModifierClass == UCDCameraModifier_Position_Offset::StaticClass())
+	{
+		UCDCameraModifier_Position_Offset* OffsetModifier = CastChecked<UCDCameraModifier_Position_Offset>(Modifier);
+		Handle.Type = ECDBatchedModifierType::Offset;
+		Handle.Slot = OffsetBatch.Modifiers.Add(OffsetModifier);
+		OffsetBatch.Blend.Add(OffsetModifier);
+		OffsetBatch.OffsetData.Add(OffsetModifier->CameraOffsetPosition);
+		OffsetBatch.UnmodifiedPosition.Add(OffsetModifier->UnmodifiedPosition);
+		OffsetBatch.ModifiedPosition.Add(OffsetModifier->ModifiedPosition);
+	}
+	else if (ModifierClass == UCDCameraModifier_Position_Distance::StaticClass())
+	{
+		UCDCameraModifier_Position_Distance* DistanceModifier = CastChecked<UCDCameraModifier_Position_Distance>(Modifier);
+		Handle.Type = ECDBatchedModifierType::Distance;
+		Handle.Slot = DistanceBatch.Modifiers.Add(DistanceModifier);
+		DistanceBatch.Blend.Add(DistanceModifier);
+		DistanceBatch.Distance.Add(DistanceModifier->Distance);
+		DistanceBatch.DistanceBeforeAdvance.Add(DistanceModifier->Distance);
+		DistanceBatch.TargetDistance.Add(DistanceModifier->TargetDistance);
+		DistanceBatch.ChangeSmoothing.AddZeroed();
+		DistanceBatch.bSmooth.Add(false);
+	}
+	else if (ModifierClass == UCDCameraModifier_FOV_Adjust::StaticClass())
+	{
+		UCDCameraModifier_FOV_Adjust* FOVModifier = CastChecked<UCDCameraModifier_FOV_Adjust>(Modifier);
+		Handle.Type = ECDBatchedModifierType::FOVAdjust;
+		Handle.Slot = FOVBatch.Modifiers.Add(FOVModifier);
+		FOVBatch.Blend.Add(FOVModifier);
+		FOVBatch.FOVChange.Add(FOVModifier->FOVChange);
+		FOVBatch.FOVChangeBeforeAdvance.Add(FOVModifier->FOVChange);
+		FOVBatch.TargetFOVChange.Add(FOVModifier->TargetFOVChange);
+		FOVBatch.ChangedFOV.Add(FOVModifier->ChangedFOV);
+		FOVBatch.SmoothingSpeed.AddZeroed();
+		FOVBatch.bSmooth.Add(false);
+		FOVBatch.ModificationType.Add(CMO_Absolute);
+	}
+	else
+	{
+		UCDCameraModifier_Position_Lag* LagModifier = CastChecked<UCDCameraModifier_Position_Lag>(Modifier);
+		Handle.Type = ECDBatchedModifierType::Lag;
+		Handle.Slot = LagBatch.Modifiers.Add(LagModifier);
+		LagBatch.Blend.Add(LagModifier);
+		LagBatch.Params.AddDefaulted();
+		LagBatch.CameraPositionTarget.Add(LagModifier->CameraPositionTarget);
+		LagBatch.LaggedCameraPosition.Add(LagModifier->LaggedCameraPosition);
+		LagBatch.LastFrameRotation.Add(LagModifier->LastFrameRotation);
+		LagBatch.InterpSpeed.Add(LagModifier->InterpSpeed);
+		LagBatch.DistanceToTarget.Add(LagModifier->DistanceToTarget);
+	}
+
+	CaptureTuning(Handle);
+	Handles.Add(Modifier, Handle);
+	bChangedSinceAdvance = true;
+	return Handle;
+}
+
+void FCDModifierBatch::Unregister(UCameraModifier* Modifier)
+{
+	FCDBatchHandle Handle;
+	if (!Handles.RemoveAndCopyValue(Modifier, Handle)) return;
+
+	FlushSlot(Handle);
+	RemoveSlot(Handle);
+}
+
+void FCDModifierBatch::Reset()
+{
+	Flush();
+	OffsetBatch = FOffsetColumns();
+	DistanceBatch = FDistanceColumns();
+	FOVBatch = FFOVColumns();
+	LagBatch = FLagColumns();
+	Handles.Reset();
+	bChangedSinceAdvance = false;
+}
+
+void FCDModifierBatch::Refresh(UCameraModifier* Modifier)
+{
+	const FCDBatchHandle Handle = FindHandle(Modifier);
+	if (!Handle.IsValid()) return;
+
+	CaptureTuning(Handle);
+	GetBlendColumns(Handle.Type).Refresh(Handle.Slot, GetModifier(Handle));
+	bChangedSinceAdvance = true;
+}
+
+void FCDModifierBatch::RefreshBlendState(UCameraModifier* Modifier)
+{
+	const FCDBatchHandle Handle = FindHandle(Modifier);
+	if (!Handle.IsValid()) return;
+
+	GetBlendColumns(Handle.Type).Refresh(Handle.Slot, GetModifier(Handle));
+	bChangedSinceAdvance = true;
+}
+
+FCDBatchHandle FCDModifierBatch::FindHandle(const UCameraModifier* Modifier) const
+{
+	const FCDBatchHandle* Handle = Handles.Find(Modifier);
+	return Handle ? *Handle : FCDBatchHandle();
+}
+
+/*
+ * Evaluation
+ */
+
+bool FCDModifierBatch::Gather()
+{
+	// Offsets are only used when evaluating, so only the smoothing targets affect Advance
+	bool bChanged = false;
+	for (int32 Slot = 0; Slot < OffsetBatch.Modifiers.Num(); ++Slot)
+	{
+		OffsetBatch.OffsetData[Slot] = OffsetBatch.Modifiers[Slot]->CameraOffsetPosition;
+	}
+	for (int32 Slot = 0; Slot < DistanceBatch.Modifiers.Num(); ++Slot)
+	{
+		const float TargetDistance = DistanceBatch.Modifiers[Slot]->TargetDistance;
+		bChanged |= TargetDistance != DistanceBatch.TargetDistance[Slot];
+		DistanceBatch.TargetDistance[Slot] = TargetDistance;
+	}
+	for (int32 Slot = 0; Slot < FOVBatch.Modifiers.Num(); ++Slot)
+	{
+		const float TargetFOVChange = FOVBatch.Modifiers[Slot]->TargetFOVChange;
+		bChanged |= TargetFOVChange != FOVBatch.TargetFOVChange[Slot];
+		FOVBatch.TargetFOVChange[Slot] = TargetFOVChange;
+	}
+	return bChanged;
+}
+
+void FCDModifierBatch::Advance(const float DeltaTime)
+{
+	// Keep the state being stepped, in case the step has to be redone with newer inputs. The blend columns keep their own.
+	DistanceBatch.DistanceBeforeAdvance = DistanceBatch.Distance;
+	FOVBatch.FOVChangeBeforeAdvance = FOVBatch.FOVChange;
+	bChangedSinceAdvance = false;
+
+	OffsetBatch.Blend.Step(DeltaTime);
+	DistanceBatch.Blend.Step(DeltaTime);
+	FOVBatch.Blend.Step(DeltaTime);
+	LagBatch.Blend.Step(DeltaTime);
+
+	// Smoothing only advances while the modifier is contributing, the same as the object path
+	for (int32 Slot = 0; Slot < DistanceBatch.Distance.Num(); ++Slot)
+	{
+		if (DistanceBatch.Blend.bDisabled[Slot] || DistanceBatch.Blend.BlendedAlpha[Slot] == 0.0f) continue;
+		DistanceBatch.Distance[Slot] = CDCameraKernels::StepSmoothedValue(
+			DistanceBatch.Distance[Slot], DistanceBatch.TargetDistance[Slot], DistanceBatch.bSmooth[Slot],
+			DistanceBatch.ChangeSmoothing[Slot], DeltaTime);
+	}
+	for (int32 Slot = 0; Slot < FOVBatch.FOVChange.Num(); ++Slot)
+	{
+		if (FOVBatch.Blend.bDisabled[Slot] || FOVBatch.Blend.BlendedAlpha[Slot] == 0.0f) continue;
+		FOVBatch.FOVChange[Slot] = CDCameraKernels::StepSmoothedValue(
+			FOVBatch.FOVChange[Slot], FOVBatch.TargetFOVChange[Slot], FOVBatch.bSmooth[Slot],
+			FOVBatch.SmoothingSpeed[Slot], DeltaTime);
+	}
+}
+
+void FCDModifierBatch::Rewind()
+{
+	// BlendedAlpha is left stale, it is only read after the next Advance
+	OffsetBatch.Blend.Alpha = OffsetBatch.Blend.AlphaBeforeAdvance;
+	DistanceBatch.Blend.Alpha = DistanceBatch.Blend.AlphaBeforeAdvance;
+	FOVBatch.Blend.Alpha = FOVBatch.Blend.AlphaBeforeAdvance;
+	LagBatch.Blend.Alpha = LagBatch.Blend.AlphaBeforeAdvance;
+	DistanceBatch.Distance = DistanceBatch.DistanceBeforeAdvance;
+	FOVBatch.FOVChange = FOVBatch.FOVChangeBeforeAdvance;
+}
+
+void FCDModifierBatch::RewindSlot(const FCDBatchHandle& Handle)
+{
+	if (!Handle.IsValid()) return;
+
+	GetBlendColumns(Handle.Type).RewindSlot(Handle.Slot);
+	if (Handle.Type == ECDBatchedModifierType::Distance)
+	{
+		DistanceBatch.Distance[Handle.Slot] = DistanceBatch.DistanceBeforeAdvance[Handle.Slot];
+	}
+	else if (Handle.Type == ECDBatchedModifierType::FOVAdjust)
+	{
+		FOVBatch.FOVChange[Handle.Slot] = FOVBatch.FOVChangeBeforeAdvance[Handle.Slot];
+	}
+}
+
+void FCDModifierBatch::Evaluate(const FCDBatchHandle& Handle, const float DeltaTime, const FVector* PawnVelocity,
+                                FCDCameraPose& InOutPose)
+{
+	const FCDBatchBlendColumns& Blend = GetBlendColumns(Handle.Type);
+	const int32 Slot = Handle.Slot;
+	if (Blend.bDisabled[Slot]) return;
+
+	const float A = Blend.BlendedAlpha[Slot];
+	if (A == 0.0f) return;
+
+	const FVector ViewLocation = InOutPose.Location;
+	const float ViewFOV = InOutPose.FOV;
+
+	switch (Handle.Type)
+	{
+	case ECDBatchedModifierType::Offset:
+		OffsetBatch.UnmodifiedPosition[Slot] = ViewLocation;
+		OffsetBatch.ModifiedPosition[Slot] = OffsetBatch.OffsetData[Slot].GetOffsetPosition(ViewLocation, InOutPose.Rotation);
+		InOutPose.Location = OffsetBatch.ModifiedPosition[Slot];
+		break;
+	case ECDBatchedModifierType::Distance:
+		InOutPose.Location = CDCameraKernels::ApplyForwardDistance(ViewLocation, InOutPose.Rotation, DistanceBatch.Distance[Slot]);
+		break;
+	case ECDBatchedModifierType::FOVAdjust:
+		FOVBatch.ChangedFOV[Slot] = CDCameraKernels::ApplyFOVChange(ViewFOV, FOVBatch.FOVChange[Slot], FOVBatch.ModificationType[Slot]);
+		InOutPose.FOV = FOVBatch.ChangedFOV[Slot];
+		break;
+	case ECDBatchedModifierType::Lag:
+		LagBatch.CameraPositionTarget[Slot] = ViewLocation;
+		InOutPose.Location = CDCameraKernels::StepPositionLag(LagBatch.Params[Slot], ViewLocation, InOutPose.Rotation,
+		                                                     PawnVelocity, DeltaTime, LagBatch.LaggedCameraPosition[Slot],
+		                                                     LagBatch.LastFrameRotation[Slot], LagBatch.InterpSpeed[Slot],
+		                                                     LagBatch.DistanceToTarget[Slot]);
+		break;
+	default:
+		break;
+	}
+
+	// Early return if this modifier is fully active
+	if (A == 1.0f) return;
+
+	// None of the batched modifiers change the rotation, so only location and FOV need blending
+	InOutPose.Location = FMath::Lerp(ViewLocation, InOutPose.Location, A);
+	InOutPose.FOV = FMath::Lerp(ViewFOV, InOutPose.FOV, A);
+}
+
+bool FCDModifierBatch::IsFullyBlendedIn(const FCDBatchHandle& Handle) const
+{
+	const FCDBatchBlendColumns& Blend = GetBlendColumns(Handle.Type);
+	return !Blend.bDisabled[Handle.Slot] && Blend.BlendedAlpha[Handle.Slot] == 1.0f;
+}
+
+void FCDModifierBatch::ResumeFromMasked(const FCDBatchHandle& Handle, const FCDCameraPose& ViewPose)
+{
+	// Lag is the only batched type with state that follows the pose, the others are smoothed in Advance
+	if (Handle.Type != ECDBatchedModifierType::Lag) return;
+
+	const int32 Slot = Handle.Slot;
+	LagBatch.CameraPositionTarget[Slot] = ViewPose.Location;
+	LagBatch.LaggedCameraPosition[Slot] = ViewPose.Location;
+	LagBatch.LastFrameRotation[Slot] = ViewPose.Rotation;
+	LagBatch.DistanceToTarget[Slot] = 0.0f;
+}
+
+void FCDModifierBatch::Finish()
+{
+	auto FinishType = [](auto& Modifiers, FCDBatchBlendColumns& Blend)
+	{
+		for (int32 Slot = 0; Slot < Modifiers.Num(); ++Slot)
+		{
+			UCDCameraModifierInstanced* Modifier = Modifiers[Slot];
+			Modifier->SetResolvedAlpha(Blend.Alpha[Slot], Blend.BlendedAlpha[Slot]);
+			Modifier->bDrawDebugInfoThisFrame = false;
+
+			// If pending disable and fully alpha'd out, truly disable this modifier
+			if (Blend.bPendingDisable[Slot] && Blend.Alpha[Slot] <= 0.0f)
+			{
+				Modifier->DisableModifier(true);
+			}
+		}
+	};
+	FinishType(OffsetBatch.Modifiers, OffsetBatch.Blend);
+	FinishType(DistanceBatch.Modifiers, DistanceBatch.Blend);
+	FinishType(FOVBatch.Modifiers, FOVBatch.Blend);
+	FinishType(LagBatch.Modifiers, LagBatch.Blend);
+}
+
+void FCDModifierBatch::Flush()
+{
+	for (const TPair<const UCameraModifier*, FCDBatchHandle>& Pair : Handles)
+	{
+		FlushSlot(Pair.Value);
+	}
+}
+
+/*
+ * Internal
+ */
+
+FCDBatchBlendColumns& FCDModifierBatch::GetBlendColumns(const ECDBatchedModifierType Type)
+{
+	switch (Type)
+	{
+	case ECDBatchedModifierType::Distance:	return DistanceBatch.Blend;
+	case ECDBatchedModifierType::FOVAdjust:	return FOVBatch.Blend;
+	case ECDBatchedModifierType::Lag:		return LagBatch.Blend;
+	default:								return OffsetBatch.Blend;
+	}
+}
+
+const FCDBatchBlendColumns& FCDModifierBatch::GetBlendColumns(const ECDBatchedModifierType Type) const
+{
+	return const_cast<FCDModifierBatch*>(this)->GetBlendColumns(Type);
+}
+
+UCDCameraModifierInstanced* FCDModifierBatch::GetModifier(const FCDBatchHandle& Handle) const
+{
+	switch (Handle.Type)
+	{
+	case ECDBatchedModifierType::Offset:	return OffsetBatch.Modifiers[Handle.Slot];
+	case ECDBatchedModifierType::Distance:	return DistanceBatch.Modifiers[Handle.Slot];
+	case ECDBatchedModifierType::FOVAdjust:	return FOVBatch.Modifiers[Handle.Slot];
+	case ECDBatchedModifierType::Lag:		return LagBatch.Modifiers[Handle.Slot];
+	default:								return nullptr;
+	}
+}
+
+void FCDModifierBatch::CaptureTuning(const FCDBatchHandle& Handle)
+{
+	const int32 Slot = Handle.Slot;
+	switch (Handle.Type)
+	{
+	case ECDBatchedModifierType::Distance:
+		DistanceBatch.ChangeSmoothing[Slot] = DistanceBatch.Modifiers[Slot]->ChangeSmoothing;
+		DistanceBatch.bSmooth[Slot] = DistanceBatch.Modifiers[Slot]->bSmoothDistanceChanges;
+		break;
+	case ECDBatchedModifierType::FOVAdjust:
+		FOVBatch.SmoothingSpeed[Slot] = FOVBatch.Modifiers[Slot]->SmoothingSpeed;
+		FOVBatch.bSmooth[Slot] = FOVBatch.Modifiers[Slot]->bUseSmoothing;
+		FOVBatch.ModificationType[Slot] = FOVBatch.Modifiers[Slot]->ModificationType;
+		break;
+	case ECDBatchedModifierType::Lag:
+		LagBatch.Params[Slot] = LagBatch.Modifiers[Slot]->MakeLagParams();
+		break;
+	default:
+		break;
+	}
+}
+
+void FCDModifierBatch::FlushSlot(const FCDBatchHandle& Handle)
+{
+	const int32 Slot = Handle.Slot;
+	switch (Handle.Type)
+	{
+	case ECDBatchedModifierType::Offset:
+		OffsetBatch.Modifiers[Slot]->Alpha = OffsetBatch.Blend.Alpha[Slot];
+		OffsetBatch.Modifiers[Slot]->UnmodifiedPosition = OffsetBatch.UnmodifiedPosition[Slot];
+		OffsetBatch.Modifiers[Slot]->ModifiedPosition = OffsetBatch.ModifiedPosition[Slot];
+		break;
+	case ECDBatchedModifierType::Distance:
+		DistanceBatch.Modifiers[Slot]->Alpha = DistanceBatch.Blend.Alpha[Slot];
+		DistanceBatch.Modifiers[Slot]->Distance = DistanceBatch.Distance[Slot];
+		break;
+	case ECDBatchedModifierType::FOVAdjust:
+		FOVBatch.Modifiers[Slot]->Alpha = FOVBatch.Blend.Alpha[Slot];
+		FOVBatch.Modifiers[Slot]->FOVChange = FOVBatch.FOVChange[Slot];
+		FOVBatch.Modifiers[Slot]->ChangedFOV = FOVBatch.ChangedFOV[Slot];
+		break;
+	case ECDBatchedModifierType::Lag:
+		LagBatch.Modifiers[Slot]->Alpha = LagBatch.Blend.Alpha[Slot];
+		LagBatch.Modifiers[Slot]->CameraPositionTarget = LagBatch.CameraPositionTarget[Slot];
+		LagBatch.Modifiers[Slot]->LaggedCameraPosition = LagBatch.LaggedCameraPosition[Slot];
+		LagBatch.Modifiers[Slot]->LastFrameRotation = LagBatch.LastFrameRotation[Slot];
+		LagBatch.Modifiers[Slot]->InterpSpeed = LagBatch.InterpSpeed[Slot];
+		LagBatch.Modifiers[Slot]->DistanceToTarget = LagBatch.DistanceToTarget[Slot];
+		break;
+	default:
+		break;
+	}
+}
+
+void FCDModifierBatch::RemoveSlot(const FCDBatchHandle& Handle)
+{
+	const int32 Slot = Handle.Slot;
+	const UCameraModifier* MovedModifier = nullptr;
+	switch (Handle.Type)
+	{
+	case ECDBatchedModifierType::Offset:
+		RemoveColumnsAtSwap(Slot, OffsetBatch.Modifiers, OffsetBatch.OffsetData, OffsetBatch.UnmodifiedPosition,
+		                    OffsetBatch.ModifiedPosition);
+		OffsetBatch.Blend.RemoveAtSwap(Slot);
+		if (OffsetBatch.Modifiers.IsValidIndex(Slot)) MovedModifier = OffsetBatch.Modifiers[Slot];
+		break;
+	case ECDBatchedModifierType::Distance:
+		RemoveColumnsAtSwap(Slot, DistanceBatch.Modifiers, DistanceBatch.Distance, DistanceBatch.DistanceBeforeAdvance,
+		                    DistanceBatch.TargetDistance, DistanceBatch.ChangeSmoothing, DistanceBatch.bSmooth);
+		DistanceBatch.Blend.RemoveAtSwap(Slot);
+		if (DistanceBatch.Modifiers.IsValidIndex(Slot)) MovedModifier = DistanceBatch.Modifiers[Slot];
+		break;
+	case ECDBatchedModifierType::FOVAdjust:
+		RemoveColumnsAtSwap(Slot, FOVBatch.Modifiers, FOVBatch.FOVChange, FOVBatch.FOVChangeBeforeAdvance, FOVBatch.TargetFOVChange,
+		                    FOVBatch.ChangedFOV, FOVBatch.SmoothingSpeed, FOVBatch.bSmooth, FOVBatch.ModificationType);
+		FOVBatch.Blend.RemoveAtSwap(Slot);
+		if (FOVBatch.Modifiers.IsValidIndex(Slot)) MovedModifier = FOVBatch.Modifiers[Slot];
+		break;
+	case ECDBatchedModifierType::Lag:
+		RemoveColumnsAtSwap(Slot, LagBatch.Modifiers, LagBatch.Params, LagBatch.CameraPositionTarget,
+		                    LagBatch.LaggedCameraPosition, LagBatch.LastFrameRotation, LagBatch.InterpSpeed,
+		                    LagBatch.DistanceToTarget);
+		LagBatch.Blend.RemoveAtSwap(Slot);
+		if (LagBatch.Modifiers.IsValidIndex(Slot)) MovedModifier = LagBatch.Modifiers[Slot];
+		break;
+	default:
+		break;
+	}
+
+	// The last modifier of this type was swapped into the removed slot
+	if (MovedModifier)
+	{
+		Handles.FindChecked(MovedModifier).Slot = Slot;
+	}
+}
@@ -0,0 +1,75 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "CDModifierIndex.h"
+#include "Camera/CameraModifier.h"
+#include "Modifiers/CDCameraModifier_Instanced.h"
+
+TConstArrayView<UCameraModifier*> FCDModifierIndex::GetModifiersOfClass(const TArray<TObjectPtr<UCameraModifier>>& ModifierList,
+                                                                        const UClass* ModifierClass)
+{
+	if (bDirty) Rebuild(ModifierList);
+	Stats.Queries++;
+	if (!ModifierClass) return TConstArrayView<UCameraModifier*>();
+
+	if (const TArray<UCameraModifier*>* Bucket = ByClass.Find(ModifierClass)) return *Bucket;
+
+	// First query for this class since the list changed, build its bucket
+	Stats.ClassBucketsBuilt++;
+	TArray<UCameraModifier*>& NewBucket = ByClass.Add(ModifierClass);
+	for (UCameraModifier* Modifier : ModifierList)
+	{
+		if (Modifier && Modifier->IsA(ModifierClass)) NewBucket.Add(Modifier);
+	}
+	return NewBucket;
+}
+
+TConstArrayView<UCameraModifier*> FCDModifierIndex::GetCandidates(const TArray<TObjectPtr<UCameraModifier>>& ModifierList,
+                                                                  const UClass* ModifierClass, const FGameplayTagContainer& RequiredTags,
+                                                                  bool& bOutNeedsFilter)
+{
+	TConstArrayView<UCameraModifier*> Candidates = GetModifiersOfClass(ModifierList, ModifierClass);
+	bOutNeedsFilter = false;
+	if (RequiredTags.IsEmpty()) return Candidates;
+
+	// Use the smallest tag bucket if it is smaller than the class bucket
+	bOutNeedsFilter = true;
+	for (const FGameplayTag& Tag : RequiredTags)
+	{
+		const TArray<UCameraModifier*>* TagBucket = ByTag.Find(Tag);
+		if (!TagBucket) return TConstArrayView<UCameraModifier*>();	// Nothing has this tag
+		if (TagBucket->Num() < Candidates.Num()) Candidates = *TagBucket;
+	}
+	return Candidates;
+}
+
+bool FCDModifierIndex::MatchesQuery(const UCameraModifier* Modifier, const UClass* ModifierClass,
+                                    const FGameplayTagContainer& RequiredTags)
+{
+	Stats.CandidatesTested++;
+	if (!Modifier || !Modifier->IsA(ModifierClass)) return false;
+	if (RequiredTags.IsEmpty()) return true;
+
+	const UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
+	return IsValid(InstancedModifier) && InstancedModifier->ModifierGameplayTags.HasAll(RequiredTags);
+}
+
+void FCDModifierIndex::Rebuild(const TArray<TObjectPtr<UCameraModifier>>& ModifierList)
+{
+	Stats.Rebuilds++;
+	ByClass.Reset();
+	ByTag.Reset();
+
+	for (UCameraModifier* Modifier : ModifierList)
+	{
+		const UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
+		if (!IsValid(InstancedModifier)) continue;
+
+		// HasAll also matches parent tags, so index the modifier under those too
+		for (const FGameplayTag& Tag : InstancedModifier->ModifierGameplayTags.GetGameplayTagParents())
+		{
+			ByTag.FindOrAdd(Tag).Add(Modifier);
+		}
+	}
+	bDirty = false;
+}
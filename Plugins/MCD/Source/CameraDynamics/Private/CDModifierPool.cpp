@@ -0,0 +1,100 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "CDModifierPool.h"
+#include "CameraDynamics.h"
+#include "Modifiers/CDCameraModifier_Instanced.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Modifier Pool Acquire"), STAT_Camera_ModifierPoolAcquire, STATGROUP_Game);
+
+UCDCameraModifierInstanced* FCDModifierPool::Acquire(UCDCameraModifierInstanced* SourceModifier, UObject* Outer)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Camera_ModifierPoolAcquire);
+	if (!IsValid(SourceModifier)) return nullptr;
+
+	if (FCDPooledModifierList* PooledList = FreeModifiers.Find(SourceModifier))
+	{
+		while (!PooledList->Modifiers.IsEmpty())
+		{
+			UCDCameraModifierInstanced* Modifier = PooledList->Modifiers.Pop(EAllowShrinking::No);
+			if (!IsValid(Modifier)) continue;
+
+			CopyFromSource(SourceModifier, Modifier);
+			Hits++;
+			return Modifier;
+		}
+	}
+
+	Misses++;
+	return Duplicate(SourceModifier, Outer);
+}
+
+bool FCDModifierPool::Release(UCDCameraModifierInstanced* Modifier)
+{
+	if (!IsValid(Modifier)) return false;
+
+	UCDCameraModifierInstanced* SourceModifier = Modifier->SourceModifier.Get();
+	if (!IsValid(SourceModifier) || SourceModifier->GetClass() != Modifier->GetClass()) return false;
+
+	FCDPooledModifierList& PooledList = FreeModifiers.FindOrAdd(SourceModifier);
+	if (PooledList.Modifiers.Num() >= MaxPooledPerSource) return false;
+	if (PooledList.Modifiers.Contains(Modifier)) return true;
+
+	Modifier->ResetForPool();
+	PooledList.Modifiers.Add(Modifier);
+	return true;
+}
+
+void FCDModifierPool::WarmUp(UCDCameraModifierInstanced* SourceModifier, UObject* Outer, const int32 Count)
+{
+	if (!IsValid(SourceModifier)) return;
+
+	FCDPooledModifierList& PooledList = FreeModifiers.FindOrAdd(SourceModifier);
+	const int32 TargetCount = FMath::Min(Count, MaxPooledPerSource);
+	while (PooledList.Modifiers.Num() < TargetCount)
+	{
+		UCDCameraModifierInstanced* Modifier = Duplicate(SourceModifier, Outer);
+		if (!IsValid(Modifier)) return;
+		PooledList.Modifiers.Add(Modifier);
+	}
+}
+
+void FCDModifierPool::Empty()
+{
+	FreeModifiers.Empty();
+	Hits = 0;
+	Misses = 0;
+}
+
+int32 FCDModifierPool::GetNumPooled() const
+{
+	int32 NumPooled = 0;
+	for (const TPair<TObjectPtr<UCDCameraModifierInstanced>, FCDPooledModifierList>& Pair : FreeModifiers)
+	{
+		NumPooled += Pair.Value.Modifiers.Num();
+	}
+	return NumPooled;
+}
+
+UCDCameraModifierInstanced* FCDModifierPool::Duplicate(UCDCameraModifierInstanced* SourceModifier, UObject* Outer)
+{
+	UCDCameraModifierInstanced* Modifier = DuplicateObject(SourceModifier, Outer);
+	if (!IsValid(Modifier))
+	{
+		UE_LOG(LogCameraDynamics, Error, TEXT("Failed to duplicate camera modifier %s"), *SourceModifier->GetName());
+		return nullptr;
+	}
+	Modifier->SourceModifier = SourceModifier;
+	return Modifier;
+}
+
+void FCDModifierPool::CopyFromSource(const UCDCameraModifierInstanced* SourceModifier, UCDCameraModifierInstanced* Modifier)
+{
+	// Same properties that DuplicateObject would copy, without creating a new object
+	for (TFieldIterator<FProperty> It(SourceModifier->GetClass()); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient)) continue;
+		Property->CopyCompleteValue_InContainer(Modifier, SourceModifier);
+	}
+}
@@ -4,127 +4,377 @@
 #include "CDPlayerCameraManager.h"
 #include "CameraDynamics.h"
 #include "CameraDynamicsFunctionLibrary.h"
+#include "CDCameraPose.h"
 #include "CDCameraStack.h"
 #include "IXRTrackingSystem.h"
+#include "Algo/StableSort.h"
 #include "Engine/Engine.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "CDCameraProgram.h"
 #include "Modifiers/CDCameraModifier_Instanced.h"
+#include "Modifiers/CDCameraModifier_Program.h"
 
 DECLARE_CYCLE_STAT(TEXT("Camera ProcessViewRotation CameraDynamics"), STAT_Camera_ProcessViewRotation_CameraDynamics, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Camera ApplyCameraModifiers CameraDynamics"), STAT_Camera_ApplyCameraModifiers_CameraDynamics, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Camera CommitStackTransaction"), STAT_Camera_CommitStackTransaction, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Camera ModifierQuery"), STAT_Camera_ModifierQuery, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Camera RemoveFinishedModifiers"), STAT_Camera_RemoveFinishedModifiers, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Camera StepPackedAlphas"), STAT_Camera_StepPackedAlphas, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Camera ReadCameraParameters"), STAT_Camera_ReadCameraParameters, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Camera FindMaskedModifiers"), STAT_Camera_FindMaskedModifiers, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Deferred Modifiers"), STAT_Camera_DeferredModifiers, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Sleeping Modifiers"), STAT_Camera_SleepingModifiers, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Masked Modifiers"), STAT_Camera_MaskedModifiers, STATGROUP_Game);
 
 ACDPlayerCameraManager::ACDPlayerCameraManager(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	bUseOrientationAwareRotationComposition = true;
+	bUseBatchedModifierEvaluation = false;
+	MaxPooledModifiersPerSource = 4;
+	bBatchOrderDirty = true;
+	bPackedAlphasDirty = true;
+	StackTransactionDepth = 0;
+	ModifierBudgetMicroseconds = 0.0f;
+	DeferrableCostClass = CMCC_Curve;
+	MaxDeferredFrames = 4;
+	FixedModifierCostMicroseconds = 0.0f;
+	bSkipMaskedModifiers = false;
+	bParallelPreUpdate = false;
+	BatchAdvancedFrame = 0;
+	BatchAdvancedDeltaTime = 0.0f;
+	BatchAdvancedPawn = nullptr;
+	BatchGatheredFrame = 0;
+
+	bPreUpdateAfterPawnMovement = false;
+	// Both ticks are enabled once there is a pawn movement component to wait on
+	CaptureTickFunction.bCanEverTick = true;
+	CaptureTickFunction.bStartWithTickEnabled = false;
+	CaptureTickFunction.bAllowTickOnDedicatedServer = false;
+	CaptureTickFunction.TickGroup = TG_PrePhysics;
+	PreUpdateTickFunction.bCanEverTick = true;
+	PreUpdateTickFunction.bStartWithTickEnabled = false;
+	PreUpdateTickFunction.bRunOnAnyThread = true;
+	PreUpdateTickFunction.bAllowTickOnDedicatedServer = false;
+	// Can run any time after the pawn has moved, as long as it finishes before the camera update
+	PreUpdateTickFunction.TickGroup = TG_PrePhysics;
+	PreUpdateTickFunction.EndTickGroup = TG_PostUpdateWork;
 }
 
 void ACDPlayerCameraManager::InitializeFor(APlayerController* PC)
 {
 	Super::InitializeFor(PC);
+	ModifierPool.MaxPooledPerSource = MaxPooledModifiersPerSource;
 	if (IsValid(DefaultCameraData)) AddCameraData(DefaultCameraData); // Add the default camera data, if there is any
 }
 
 
-void ACDPlayerCameraManager::AddCameraData(UCDCameraData* NewCameraData)
+void ACDPlayerCameraManager::UpdateCamera(float DeltaTime)
 {
-	if (!IsValid(NewCameraData)) return; // Early return if the camera data is invalid
-	
-	// Add the instanced camera modifiers to the camera manager
-    if (NewCameraData->CameraModifiers.Num() > 0)
-    {
-    	int32 Index = 0;
-    	const int32 InitialModCount = ModifierList.Num();
-    	for (UCDCameraModifierInstanced* CameraModifier : NewCameraData->CameraModifiers)
-    	{
-    		if (CameraModifier)
-    		{
-    			// Duplicate the camera modifier and set the camera data source on the duplicate modifier
-    			UCDCameraModifierInstanced* RuntimeModifier = DuplicateObject(CameraModifier, this);
-    			RuntimeModifier->CameraDataSource = NewCameraData;
-    			CameraModifier->RuntimeModifier = RuntimeModifier;
-
-				if (!IsValid(RuntimeModifier))
-				{
-					UE_LOG(LogCameraDynamics, Error, TEXT("Failed to duplicate camera modifier %s"), *CameraModifier->GetName());
-					continue;
-				}
-    			
-    			
-    		    if (!RuntimeModifier->bUseCustomPriority)
-                {
-                    // Set the camera's priority to be the same as the index in the array, plus the initial modifier count
-                    RuntimeModifier->Priority = InitialModCount + Index;
-                }
-    			// This is using an internal function that bypasses the normal method of adding camera modifiers
-    			// The normal method uses TSubClassOf, and we want the modifiers to be EditInline
-    			AddCameraModifierToList(RuntimeModifier);
-    		}
-    		Index++;
-    	}
-
-    	// Promote the new camera data as the active camera data
-    	CameraDataList.Add(NewCameraData);
-    }
+	// Ticks are done for this frame, so the pre-update can safely wait on a new pawn's movement from the next frame
+	if (PreUpdateTickFunction.IsTickFunctionRegistered()) UpdatePreUpdatePrerequisite();
+
+	Super::UpdateCamera(DeltaTime);
+}
+
+FCDCameraDataHandle ACDPlayerCameraManager::AddCameraData(UCDCameraData* NewCameraData)
+{
+	if (!IsValid(NewCameraData)) return FCDCameraDataHandle(); // Early return if the camera data is invalid
+
+	// Queue the camera data, the modifiers are added to the list when the transaction is committed
+	const FCDCameraDataHandle Handle = AllocateInstance(NewCameraData);
+	BeginStackTransaction();
+	PendingStackChanges.Add({NewCameraData, Handle, true});
+	CommitStackTransaction();
+	return Handle;
 }
 
 bool ACDPlayerCameraManager::RemoveCameraData(UCDCameraData* CameraData)
 {
 	if (!IsValid(CameraData)) return false; // Early return if the camera data is invalid
-	
-	if (!CameraDataList.Contains(CameraData)) return false; // Early return if the camera data isn't in the list
-	
-	for (UCameraModifier* Modifier : CameraData->CameraModifiers)
+
+	const TArray<int32, TInlineAllocator<1>>* Instances = InstancesByCameraData.Find(CameraData);
+	if (!Instances) return false; // Early return if the camera data isn't on this camera manager
+
+	// If this camera data is waiting to be added, cancel the newest add instead
+	for (int32 Idx = Instances->Num() - 1; Idx >= 0; --Idx)
 	{
-		UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
-		if (!IsValid(InstancedModifier)) continue; // Early continue if the modifier isn't instanced
-		
-		// If the modifier's runtime modifier is in the list of modifiers, mark it for removal
-		if (ModifierList.Contains(InstancedModifier->RuntimeModifier))
+		const int32 InstanceIndex = (*Instances)[Idx];
+		if (!CameraDataInstances[InstanceIndex].bApplied) return RemoveCameraDataByHandle(GetInstanceHandle(InstanceIndex));
+	}
+
+	// Otherwise remove the oldest instance that isn't already being removed
+	for (const int32 InstanceIndex : *Instances)
+	{
+		if (!CameraDataInstances[InstanceIndex].bPendingRemoval) return RemoveCameraDataByHandle(GetInstanceHandle(InstanceIndex));
+	}
+	return false;
+}
+
+bool ACDPlayerCameraManager::RemoveCameraDataByHandle(FCDCameraDataHandle Handle)
+{
+	FCDCameraDataInstance* Instance = FindInstance(Handle);
+	if (!Instance || Instance->bPendingRemoval) return false;
+
+	// If the add hasn't been applied yet, cancel it
+	if (!Instance->bApplied)
+	{
+		PendingStackChanges.RemoveAll([&Handle](const FCDPendingStackChange& Change)
+		{
+			return Change.bAdd && Change.Handle == Handle;
+		});
+		FreeInstance(Handle);
+		return true;
+	}
+
+	Instance->bPendingRemoval = true;
+	BeginStackTransaction();
+	PendingStackChanges.Add({Instance->CameraData, Handle, false});
+	CommitStackTransaction();
+	return true;
+}
+
+UCDCameraModifierInstanced* ACDPlayerCameraManager::GetRuntimeModifier(FCDCameraDataHandle Handle, int32 ModifierIndex) const
+{
+	const FCDCameraDataInstance* Instance = FindInstance(Handle);
+	if (!Instance || !Instance->RuntimeModifiers.IsValidIndex(ModifierIndex)) return nullptr;
+	return Instance->RuntimeModifiers[ModifierIndex];
+}
+
+void ACDPlayerCameraManager::SwapCameraData(UCDCameraData* OldCameraData, UCDCameraData* NewCameraData)
+{
+	BeginStackTransaction();
+	RemoveCameraData(OldCameraData);
+	AddCameraData(NewCameraData);
+	CommitStackTransaction();
+}
+
+void ACDPlayerCameraManager::BeginStackTransaction()
+{
+	StackTransactionDepth++;
+}
+
+void ACDPlayerCameraManager::CommitStackTransaction()
+{
+	if (StackTransactionDepth <= 0)
+	{
+		UE_LOG(LogCameraDynamics, Warning, TEXT("CommitStackTransaction called on %s without a matching BeginStackTransaction"),
+		       *GetNameSafe(this));
+		return;
+	}
+	if (--StackTransactionDepth > 0) return;	// Only the outermost transaction applies the changes
+	if (PendingStackChanges.IsEmpty()) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_Camera_CommitStackTransaction);
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+
+	// Move the changes out, as removing modifiers can queue further changes
+	TArray<FCDPendingStackChange> Changes = MoveTemp(PendingStackChanges);
+	TArray<UCDCameraModifierInstanced*, TInlineAllocator<16>> AddedModifiers;
+	for (const FCDPendingStackChange& Change : Changes)
+	{
+		if (Change.bAdd) ApplyCameraDataAdd(Change.Handle, AddedModifiers);
+		else ApplyCameraDataRemoval(Change.Handle);
+	}
+	if (AddedModifiers.IsEmpty()) return;
+
+	// Sort the list once, new modifiers go after existing modifiers of the same priority. Null entries go to the end.
+	Algo::StableSort(ModifierList, [](const TObjectPtr<UCameraModifier>& A, const TObjectPtr<UCameraModifier>& B)
+	{
+		if (!A || !B) return A && !B;
+		return A->Priority < B->Priority;
+	});
+
+	/* Compact the priorities so they don't keep growing as camera data is added and removed.
+	Custom priorities and modifiers added by anything other than camera data keep their priority, so the others are only
+	lowered, never past the modifier before them, which keeps the list in the same order for later sorts. */
+	int32 PreviousPriority = -1;
+	for (UCameraModifier* Modifier : ModifierList)
+	{
+		if (!Modifier) continue;
+
+		const UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
+		if (InstancedModifier && !InstancedModifier->bUseCustomPriority && InstancedModifier->CameraDataHandle.IsValid())
+		{
+			Modifier->Priority = FMath::Min<int32>(Modifier->Priority, PreviousPriority + 1);
+		}
+		PreviousPriority = Modifier->Priority;
+	}
+
+	for (UCDCameraModifierInstanced* RuntimeModifier : AddedModifiers)
+	{
+		RuntimeModifier->AddedToCamera(this);
+		BindCameraParameters(RuntimeModifier);
+		if (bUseBatchedModifierEvaluation) ModifierBatch.Register(RuntimeModifier);
+	}
+	OnModifierListChanged();
+}
+
+void ACDPlayerCameraManager::ApplyCameraDataAdd(const FCDCameraDataHandle& Handle,
+                                                TArray<UCDCameraModifierInstanced*, TInlineAllocator<16>>& OutAddedModifiers)
+{
+	FCDCameraDataInstance* Instance = FindInstance(Handle);
+	if (!Instance) return;
+
+	UCDCameraData* NewCameraData = Instance->CameraData;
+	if (!IsValid(NewCameraData))
+	{
+		FreeInstance(Handle);
+		return;
+	}
+
+	// Promote the new camera data as the active camera data
+	Instance->bApplied = true;
+	CameraDataList.Add(NewCameraData);
+
+	// Declare the parameters before any modifiers are bound, so modifiers can bind to parameters of other camera data
+	for (const FCDCameraParameterDefinition& Definition : NewCameraData->Parameters)
+	{
+		CameraBlackboard.Declare(Definition);
+	}
+
+	// Add the instanced camera modifiers to the camera manager
+	Instance->RuntimeModifiers.SetNum(NewCameraData->CameraModifiers.Num());
+	const int32 InitialModCount = ModifierList.Num();
+	const TSharedPtr<const FCDCameraProgram> Program = NewCameraData->GetCameraProgram();
+	UCDCameraModifier_Program* ProgramModifier = nullptr;
+	for (int32 Index = 0; Index < NewCameraData->CameraModifiers.Num(); ++Index)
+	{
+		UCDCameraModifierInstanced* CameraModifier = NewCameraData->CameraModifiers[Index];
+		if (Program.IsValid() && Program->IsSourceCompiled(Index))
+		{
+			// Compiled modifiers are run by one program modifier for each run of the program
+			const int32 RunIndex = Program->RunStartingAtSource[Index];
+			if (RunIndex != INDEX_NONE)
+			{
+				ProgramModifier = NewObject<UCDCameraModifier_Program>(this);
+				ProgramModifier->InitializeProgram(Program.ToSharedRef(), RunIndex, CameraModifier);
+				ProgramModifier->CameraDataSource = NewCameraData;
+				ProgramModifier->CameraDataHandle = Handle;
+				ProgramModifier->Priority = FMath::Min(InitialModCount + Index, static_cast<int32>(MAX_uint8));
+				ModifierList.Add(ProgramModifier);
+				OutAddedModifiers.Add(ProgramModifier);
+			}
+			// Point every compiled modifier at the program modifier, so removing the camera data finds it
+			Instance->RuntimeModifiers[Index] = ProgramModifier;
+		}
+		else if (CameraModifier)
+		{
+			// Get a runtime copy of the camera modifier, reusing a pooled one if possible
+			UCDCameraModifierInstanced* RuntimeModifier = ModifierPool.Acquire(CameraModifier, this);
+			if (!IsValid(RuntimeModifier)) continue;	// The pool logs the failed duplication
+
+			// Set the camera data source on the runtime modifier
+			RuntimeModifier->CameraDataSource = NewCameraData;
+			RuntimeModifier->CameraDataHandle = Handle;
+			Instance->RuntimeModifiers[Index] = RuntimeModifier;
+#if WITH_EDITOR
+			CameraModifier->EditorRuntimeModifiers.AddUnique(RuntimeModifier);
+#endif
+
+			if (!RuntimeModifier->bUseCustomPriority)
+			{
+				// Set the camera's priority to be the same as the index in the array, plus the initial modifier count
+				RuntimeModifier->Priority = FMath::Min(InitialModCount + Index, static_cast<int32>(MAX_uint8));
+			}
+			// The list is sorted once when the transaction is committed, instead of inserting each modifier by priority
+			ModifierList.Add(RuntimeModifier);
+			OutAddedModifiers.Add(RuntimeModifier);
+		}
+	}
+}
+
+void ACDPlayerCameraManager::ApplyCameraDataRemoval(const FCDCameraDataHandle& Handle)
+{
+	FCDCameraDataInstance* Instance = FindInstance(Handle);
+	if (!Instance || !Instance->bApplied) return;
+
+	for (UCDCameraModifierInstanced* RuntimeModifier : Instance->RuntimeModifiers)
+	{
+		// Modifiers removed some other way may already be in use by another instance, so check the handle
+		if (IsValid(RuntimeModifier) && RuntimeModifier->CameraDataHandle == Handle && !RuntimeModifier->bMarkedForRemoval)
 		{
 			// Mark this modifier for removal, which will blend it out then remove it from the manager
-			InstancedModifier->RuntimeModifier->MarkForRemoval();
+			RuntimeModifier->MarkForRemoval();
 		}
 	}
 	// Remove the camera data from the list
-	CameraDataList.RemoveSingle(CameraData);
-	if (CameraDataList.Contains(CameraData))
+	CameraDataList.RemoveSingle(Instance->CameraData);
+	FreeInstance(Handle);
+}
+
+FCDCameraDataHandle ACDPlayerCameraManager::AllocateInstance(UCDCameraData* CameraData)
+{
+	const int32 Index = FreeCameraDataInstances.IsEmpty()
+		                    ? CameraDataInstances.AddDefaulted()
+		                    : FreeCameraDataInstances.Pop(EAllowShrinking::No);
+
+	FCDCameraDataInstance& Instance = CameraDataInstances[Index];
+	Instance.CameraData = CameraData;
+	Instance.Serial++;	// Handles to the previous use of this entry no longer match
+	InstancesByCameraData.FindOrAdd(CameraData).Add(Index);
+	return GetInstanceHandle(Index);
+}
+
+void ACDPlayerCameraManager::FreeInstance(const FCDCameraDataHandle& Handle)
+{
+	FCDCameraDataInstance* Instance = FindInstance(Handle);
+	if (!Instance) return;
+
+	if (TArray<int32, TInlineAllocator<1>>* Instances = InstancesByCameraData.Find(Instance->CameraData))
 	{
-		UE_LOG(LogCameraDynamics, Log, TEXT("Failed to remove camera data %s"), *CameraData->GetName());
+		Instances->RemoveSingle(Handle.Index);
+		if (Instances->IsEmpty()) InstancesByCameraData.Remove(Instance->CameraData);
 	}
-	return true;
+
+	Instance->CameraData = nullptr;
+	Instance->RuntimeModifiers.Reset();
+	Instance->bApplied = false;
+	Instance->bPendingRemoval = false;
+	FreeCameraDataInstances.Add(Handle.Index);
+}
+
+FCDCameraDataHandle ACDPlayerCameraManager::GetInstanceHandle(const int32 Index) const
+{
+	FCDCameraDataHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = CameraDataInstances[Index].Serial;
+	return Handle;
+}
+
+FCDCameraDataInstance* ACDPlayerCameraManager::FindInstance(const FCDCameraDataHandle& Handle)
+{
+	return const_cast<FCDCameraDataInstance*>(static_cast<const ACDPlayerCameraManager*>(this)->FindInstance(Handle));
+}
+
+const FCDCameraDataInstance* ACDPlayerCameraManager::FindInstance(const FCDCameraDataHandle& Handle) const
+{
+	if (!CameraDataInstances.IsValidIndex(Handle.Index)) return nullptr;
+
+	const FCDCameraDataInstance& Instance = CameraDataInstances[Handle.Index];
+	return Instance.IsInUse() && Instance.Serial == Handle.Serial ? &Instance : nullptr;
 }
 
 void ACDPlayerCameraManager::RemoveAllCameraData()
 {
-	// We work with a copy of the array here as we don't want to modify the array while iterating over it
-	TArray<UCDCameraData*> CameraDataListCopy = CameraDataList;
-	for (UCDCameraData* CameraData : CameraDataListCopy)
+	// Removals are only queued inside the transaction, so the list doesn't change while iterating over it
+	BeginStackTransaction();
+	for (UCDCameraData* CameraData : CameraDataList)
 	{
 		RemoveCameraData(CameraData);
 	}
+	CommitStackTransaction();
 }
 
 UCameraModifier* ACDPlayerCameraManager::GetActiveModifierOfClass(
 	const TSubclassOf<UCameraModifier> ModifierClass, const FGameplayTagContainer& RequiredTags)
 {
-	for (UCameraModifier* Modifier : ModifierList)
+	SCOPE_CYCLE_COUNTER(STAT_Camera_ModifierQuery);
+	bool bNeedsFilter;
+	for (UCameraModifier* Modifier : ModifierIndex.GetCandidates(ModifierList, ModifierClass, RequiredTags, bNeedsFilter))
 	{
-		if (Modifier->IsA(ModifierClass))
-		{
-			if (RequiredTags.IsEmpty()) return Modifier;
-
-			const UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
-			if(!IsValid(InstancedModifier)) continue;
-
-			// If the modifier has matching gameplay tags, return that modifier
-			if (InstancedModifier->ModifierGameplayTags.HasAll(RequiredTags)) return Modifier;
-			
-			/*for (FName Tag : RequiredTags)	// Check if the modifier has the required tags, if there are required tags
-			{
-				const UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
-				if(!IsValid(InstancedModifier)) continue;
-				if (InstancedModifier->ModifierTags.Contains(Tag)) return Modifier;
-			}*/
-		}
+		if (!bNeedsFilter || ModifierIndex.MatchesQuery(Modifier, ModifierClass, RequiredTags)) return Modifier;
 	}
 	return nullptr;
 }
@@ -132,41 +382,175 @@ UCameraModifier* ACDPlayerCameraManager::GetActiveModifierOfClass(
 TArray<UCameraModifier*> ACDPlayerCameraManager::GetAllActiveModifiersOfClass(
 	const TSubclassOf<UCameraModifier>& ModifierClass, const FGameplayTagContainer& RequiredTags)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Camera_ModifierQuery);
+	bool bNeedsFilter;
+	const TConstArrayView<UCameraModifier*> Candidates = ModifierIndex.GetCandidates(ModifierList, ModifierClass, RequiredTags, bNeedsFilter);
+	if (!bNeedsFilter) return TArray<UCameraModifier*>(Candidates);
+
 	TArray<UCameraModifier*> Modifiers;
-	for (UCameraModifier* Modifier : ModifierList)
+	for (UCameraModifier* Modifier : Candidates)
 	{
-		if (Modifier->IsA(ModifierClass))
-		{
-			if (RequiredTags.IsEmpty())		// If there are no required tags, just add the modifier
-			{
-				Modifiers.Add(Modifier);
-				continue;
-			}
+		if (ModifierIndex.MatchesQuery(Modifier, ModifierClass, RequiredTags)) Modifiers.Add(Modifier);
+	}
+	return Modifiers;
+}
 
-			const UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
-			if(!IsValid(InstancedModifier)) continue;
+TConstArrayView<UCameraModifier*> ACDPlayerCameraManager::GetActiveModifiersOfClassView(const TSubclassOf<UCameraModifier> ModifierClass)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Camera_ModifierQuery);
+	return ModifierIndex.GetModifiersOfClass(ModifierList, ModifierClass);
+}
 
-			if (InstancedModifier->ModifierGameplayTags.HasAll(RequiredTags)) Modifiers.Add(Modifier);
-			
-			/*for (FName Tag : RequiredTags)	// Check if the modifier has the required tags, if there are required tags
-			{
-				const UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
-				if(!IsValid(InstancedModifier)) continue;
-				if (InstancedModifier->ModifierTags.Contains(Tag)) Modifiers.Add(Modifier);
-			}*/
+void ACDPlayerCameraManager::ForEachActiveModifierOfClass(const TSubclassOf<UCameraModifier> ModifierClass,
+                                                          const FGameplayTagContainer& RequiredTags,
+                                                          TFunctionRef<bool(UCameraModifier*)> Visitor)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Camera_ModifierQuery);
+	bool bNeedsFilter;
+	for (UCameraModifier* Modifier : ModifierIndex.GetCandidates(ModifierList, ModifierClass, RequiredTags, bNeedsFilter))
+	{
+		if (bNeedsFilter && !ModifierIndex.MatchesQuery(Modifier, ModifierClass, RequiredTags)) continue;
+		if (!Visitor(Modifier)) return;
+	}
+}
+
+FCDCameraParameterHandle ACDPlayerCameraManager::FindCameraParameter(const FName Name, const TEnumAsByte<ECDCameraParameterType> Type) const
+{
+	FCDCameraParameterHandle Handle;
+	Handle.Slot = CameraBlackboard.FindSlot(Name, Type);
+	Handle.Type = Type;
+	return Handle;
+}
+
+void ACDPlayerCameraManager::SetCameraParameterFloat(const FCDCameraParameterHandle Handle, const float Value)
+{
+	if (!CheckParameterHandle(Handle, CDPARAM_Float)) return;
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	CameraBlackboard.SetFloat(Handle.Slot, Value);
+}
+
+void ACDPlayerCameraManager::SetCameraParameterVector(const FCDCameraParameterHandle Handle, const FVector Value)
+{
+	if (!CheckParameterHandle(Handle, CDPARAM_Vector)) return;
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	CameraBlackboard.SetVector(Handle.Slot, Value);
+}
+
+void ACDPlayerCameraManager::SetCameraParameterRotator(const FCDCameraParameterHandle Handle, const FRotator Value)
+{
+	if (!CheckParameterHandle(Handle, CDPARAM_Rotator)) return;
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	CameraBlackboard.SetRotator(Handle.Slot, Value);
+}
+
+void ACDPlayerCameraManager::SetCameraParameterObject(const FCDCameraParameterHandle Handle, UObject* Value)
+{
+	if (!CheckParameterHandle(Handle, CDPARAM_Object)) return;
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	CameraBlackboard.SetObject(Handle.Slot, Value);
+}
+
+float ACDPlayerCameraManager::GetCameraParameterFloat(const FCDCameraParameterHandle Handle) const
+{
+	return CheckParameterHandle(Handle, CDPARAM_Float) ? CameraBlackboard.GetFloat(Handle.Slot) : 0.0f;
+}
+
+FVector ACDPlayerCameraManager::GetCameraParameterVector(const FCDCameraParameterHandle Handle) const
+{
+	return CheckParameterHandle(Handle, CDPARAM_Vector) ? CameraBlackboard.GetVector(Handle.Slot) : FVector::ZeroVector;
+}
+
+FRotator ACDPlayerCameraManager::GetCameraParameterRotator(const FCDCameraParameterHandle Handle) const
+{
+	return CheckParameterHandle(Handle, CDPARAM_Rotator) ? CameraBlackboard.GetRotator(Handle.Slot) : FRotator::ZeroRotator;
+}
+
+UObject* ACDPlayerCameraManager::GetCameraParameterObject(const FCDCameraParameterHandle Handle) const
+{
+	return CheckParameterHandle(Handle, CDPARAM_Object) ? CameraBlackboard.GetObject(Handle.Slot) : nullptr;
+}
+
+bool ACDPlayerCameraManager::CheckParameterHandle(const FCDCameraParameterHandle& Handle, const ECDCameraParameterType Type) const
+{
+	if (CameraBlackboard.IsValidSlot(Handle.Slot, Type)) return true;
+
+	UE_LOG(LogCameraDynamics, Warning, TEXT("Invalid camera parameter handle used on %s, find the handle with FindCameraParameter using the parameter's type"),
+	       *GetNameSafe(this));
+	return false;
+}
+
+void ACDPlayerCameraManager::BindCameraParameters(UCDCameraModifierInstanced* Modifier)
+{
+	if (!Modifier) return;
+
+	TArray<const FCDCameraParameterBinding*> Bindings;
+	Modifier->GetParameterBindings(Bindings);
+	Modifier->BoundParameterSlots.Reset();
+	for (const FCDCameraParameterBinding* Binding : Bindings)
+	{
+		Binding->Slot = INDEX_NONE;
+		if (Binding->Parameter.IsNone()) continue;
+
+		Binding->Slot = CameraBlackboard.FindSlot(Binding->Parameter, Binding->Type);
+		if (!Binding->IsBound())
+		{
+			UE_LOG(LogCameraDynamics, Warning, TEXT("%s is bound to camera parameter %s, which no added camera data declares with a matching type"),
+			       *GetNameSafe(Modifier), *Binding->Parameter.ToString());
+			continue;
 		}
+
+		// Marking the slot dirty makes the modifier read the current value on the next read pass
+		CameraBlackboard.MarkDirty(Binding->Slot);
+		Modifier->BoundParameterSlots.AddUnique(Binding->Slot);
 	}
-	return Modifiers;
+
+	if (Modifier->BoundParameterSlots.IsEmpty()) UnbindCameraParameters(Modifier);
+	else ParameterReaders.AddUnique(Modifier);
+}
+
+void ACDPlayerCameraManager::UnbindCameraParameters(UCDCameraModifierInstanced* Modifier)
+{
+	if (!Modifier) return;
+	Modifier->BoundParameterSlots.Reset();
+	ParameterReaders.RemoveSingleSwap(Modifier, EAllowShrinking::No);
+}
+
+void ACDPlayerCameraManager::ReadCameraParameters()
+{
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	if (!CameraBlackboard.IsAnyDirty()) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_Camera_ReadCameraParameters);
+	for (UCDCameraModifierInstanced* Modifier : ParameterReaders)
+	{
+		if (Modifier && CameraBlackboard.IsAnyDirty(Modifier->BoundParameterSlots)) Modifier->ReadParameters(CameraBlackboard);
+	}
+	CameraBlackboard.ClearDirty();
 }
 
 void ACDPlayerCameraManager::ProcessViewRotation(float DeltaTime, FRotator& OutViewRotation, FRotator& OutDeltaRot)
 {
 	SCOPE_CYCLE_COUNTER(STAT_Camera_ProcessViewRotation_CameraDynamics);
+	ReadCameraParameters();
+	FindMaskedModifiers(ECDCameraChannels::ViewRotation, false, false);
 	for( int32 ModifierIdx = 0; ModifierIdx < ModifierList.Num(); ModifierIdx++ )
 	{
 		if( ModifierList[ModifierIdx] != NULL && 
 			!ModifierList[ModifierIdx]->IsDisabled() )
 		{
+			// Only instanced modifiers are masked
+			UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(ModifierList[ModifierIdx]);
+			if (MaskedModifiers[ModifierIdx])
+			{
+				InstancedModifier->SkipMasked(ECDCameraChannels::ViewRotation, DeltaTime);
+				continue;
+			}
+			if (InstancedModifier && InstancedModifier->IsMasked(ECDCameraChannels::ViewRotation))
+			{
+				InstancedModifier->Unmask(ECDCameraChannels::ViewRotation,
+				                          FCDCameraPose(GetCameraLocation(), OutViewRotation.Quaternion(), GetFOVAngle()));
+			}
+
 			if( ModifierList[ModifierIdx]->ProcessViewRotation(ViewTarget.Target, DeltaTime, OutViewRotation, OutDeltaRot) )
 			{
 				break;
@@ -178,10 +562,11 @@ void ACDPlayerCameraManager::ProcessViewRotation(float DeltaTime, FRotator& OutV
 	// If we are using orientation aware rotation composition, we compose the rots with UCameraDynamicsFunctionLibrary::OrientationAwareComposeRotations
 	if (bUseOrientationAwareRotationComposition)
 	{
+		const FQuat ViewQuat = OutViewRotation.Quaternion();
 		OutViewRotation = UCameraDynamicsFunctionLibrary::OrientationAwareComposeRotations(
 			OutDeltaRot.Quaternion(),
-			OutViewRotation.Quaternion(),
-			OutViewRotation.Quaternion(),
+			ViewQuat,
+			ViewQuat,
 			-FVector::UpVector).
 		Rotator();
 	}
@@ -212,6 +597,712 @@ void ACDPlayerCameraManager::SetViewTarget(AActor* NewViewTarget, FViewTargetTra
 {
 	Super::SetViewTarget(NewViewTarget, TransitionParams);
 
-	// Adds a delegate for when view targets are changed
-	OnViewTargetChangeStart.Broadcast(NewViewTarget, TransitionParams);
+	// Most modifiers share the same blend out tag, so only check each distinct tag on the view target once
+	TArray<TPair<FName, bool>, TInlineAllocator<4>> TagResults;
+	for (UCDCameraModifierInstanced* Modifier : ViewTargetSubscribers)
+	{
+		const FName Tag = Modifier->ViewTargetBlendOutTag;
+		const TPair<FName, bool>* TagResult = TagResults.FindByPredicate([Tag](const TPair<FName, bool>& Result)
+		{
+			return Result.Key == Tag;
+		});
+		if (!TagResult) TagResult = &TagResults.Emplace_GetRef(Tag, IsValid(NewViewTarget) && NewViewTarget->ActorHasTag(Tag));
+
+		Modifier->OnViewTargetChangeStart(TagResult->Value, TransitionParams.BlendTime);
+	}
+
+	// Blueprint listeners
+	if (OnViewTargetChangeStart.IsBound()) OnViewTargetChangeStart.Broadcast(NewViewTarget, TransitionParams);
+}
+
+void ACDPlayerCameraManager::SubscribeToViewTargetChange(UCDCameraModifierInstanced* Modifier)
+{
+	if (!IsValid(Modifier) || Modifier->ViewTargetSubscriberIndex != INDEX_NONE) return;
+	Modifier->ViewTargetSubscriberIndex = ViewTargetSubscribers.Add(Modifier);
+}
+
+void ACDPlayerCameraManager::UnsubscribeFromViewTargetChange(UCDCameraModifierInstanced* Modifier)
+{
+	if (!Modifier) return;
+
+	const int32 SubscriberIndex = Modifier->ViewTargetSubscriberIndex;
+	if (!ViewTargetSubscribers.IsValidIndex(SubscriberIndex) || ViewTargetSubscribers[SubscriberIndex] != Modifier) return;
+
+	// Swap the last subscriber into the removed slot
+	ViewTargetSubscribers.RemoveAtSwap(SubscriberIndex, 1, EAllowShrinking::No);
+	if (ViewTargetSubscribers.IsValidIndex(SubscriberIndex))
+	{
+		ViewTargetSubscribers[SubscriberIndex]->ViewTargetSubscriberIndex = SubscriberIndex;
+	}
+	Modifier->ViewTargetSubscriberIndex = INDEX_NONE;
+}
+
+void ACDPlayerCameraManager::SetBatchedModifierEvaluation(bool bEnabled)
+{
+	if (bUseBatchedModifierEvaluation == bEnabled) return;
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	bUseBatchedModifierEvaluation = bEnabled;
+
+	if (bEnabled)
+	{
+		for (UCameraModifier* Modifier : ModifierList)
+		{
+			ModifierBatch.Register(Modifier);
+		}
+	}
+	else
+	{
+		// Writes the batched state back so the modifiers carry on from where they were
+		ModifierBatch.Reset();
+	}
+	bBatchOrderDirty = true;
+	bPackedAlphasDirty = true;
+}
+
+void ACDPlayerCameraManager::RefreshBatchedModifier(UCameraModifier* Modifier)
+{
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	ModifierBatch.Refresh(Modifier);
+}
+
+void ACDPlayerCameraManager::OnModifierBlendStateChanged(UCDCameraModifierInstanced* Modifier)
+{
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	ModifierBatch.RefreshBlendState(Modifier);
+	if (!bPackedAlphasDirty && Modifier->PackedAlphaSlot != INDEX_NONE)
+	{
+		PackedAlphas.Refresh(Modifier->PackedAlphaSlot, Modifier);
+	}
+}
+
+bool ACDPlayerCameraManager::AddCameraModifierToList(UCameraModifier* NewModifier)
+{
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	if (!Super::AddCameraModifierToList(NewModifier)) return false;
+
+	BindCameraParameters(Cast<UCDCameraModifierInstanced>(NewModifier));
+	if (bUseBatchedModifierEvaluation) ModifierBatch.Register(NewModifier);
+	OnModifierListChanged();
+	return true;
+}
+
+bool ACDPlayerCameraManager::RemoveCameraModifier(UCameraModifier* ModifierToRemove)
+{
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	// Write the batched state back before the modifier leaves the list
+	ModifierBatch.Unregister(ModifierToRemove);
+	ReleasePackedAlpha(Cast<UCDCameraModifierInstanced>(ModifierToRemove));
+	UnsubscribeFromViewTargetChange(Cast<UCDCameraModifierInstanced>(ModifierToRemove));
+	UnbindCameraParameters(Cast<UCDCameraModifierInstanced>(ModifierToRemove));
+	OnModifierListChanged();
+	if (!Super::RemoveCameraModifier(ModifierToRemove)) return false;
+
+	// Keep the runtime modifier around so it can be reused the next time its camera data is added
+	ModifierPool.Release(Cast<UCDCameraModifierInstanced>(ModifierToRemove));
+	return true;
+}
+
+void ACDPlayerCameraManager::ClearAllCameraModifiers()
+{
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+	ModifierBatch.Reset();
+	ModifiersPendingRemoval.Reset();
+	for (UCDCameraModifierInstanced* Modifier : PackedAlphaModifiers)
+	{
+		ReleasePackedAlpha(Modifier);
+	}
+	PackedAlphaModifiers.Reset();
+	PackedAlphas.Reset();
+	for (UCDCameraModifierInstanced* Modifier : ViewTargetSubscribers)
+	{
+		if (Modifier) Modifier->ViewTargetSubscriberIndex = INDEX_NONE;
+	}
+	ViewTargetSubscribers.Reset();
+	for (UCDCameraModifierInstanced* Modifier : ParameterReaders)
+	{
+		if (Modifier) Modifier->BoundParameterSlots.Reset();
+	}
+	ParameterReaders.Reset();
+	Super::ClearAllCameraModifiers();
+	OnModifierListChanged();
+}
+
+void ACDPlayerCameraManager::OnModifierListChanged()
+{
+	bBatchOrderDirty = true;
+	bPackedAlphasDirty = true;
+	ModifierIndex.Invalidate();
+}
+
+void ACDPlayerCameraManager::RefreshModifierIndex()
+{
+	ModifierIndex.Invalidate();
+}
+
+void ACDPlayerCameraManager::GetModifierIndexStats(int32& Queries, int32& ClassBucketsBuilt, int32& CandidatesTested, int32& Rebuilds) const
+{
+	const FCDModifierIndex::FStats& Stats = ModifierIndex.GetStats();
+	Queries = Stats.Queries;
+	ClassBucketsBuilt = Stats.ClassBucketsBuilt;
+	CandidatesTested = Stats.CandidatesTested;
+	Rebuilds = Stats.Rebuilds;
+}
+
+void ACDPlayerCameraManager::WarmUpCameraData(UCDCameraData* CameraData, int32 InstancesPerModifier)
+{
+	if (!IsValid(CameraData)) return;
+
+	ModifierPool.MaxPooledPerSource = MaxPooledModifiersPerSource;
+	for (UCDCameraModifierInstanced* CameraModifier : CameraData->CameraModifiers)
+	{
+		ModifierPool.WarmUp(CameraModifier, this, InstancesPerModifier);
+	}
+}
+
+void ACDPlayerCameraManager::GetModifierPoolStats(int32& Hits, int32& Misses, int32& NumPooled) const
+{
+	Hits = ModifierPool.Hits;
+	Misses = ModifierPool.Misses;
+	NumPooled = ModifierPool.GetNumPooled();
+}
+
+void ACDPlayerCameraManager::ApplyCameraModifiers(float DeltaTime, FMinimalViewInfo& InOutPOV)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Camera_ApplyCameraModifiers_CameraDynamics);
+
+	ClearCachedPPBlends();
+
+	const bool bUseBudget = ModifierBudgetMicroseconds > 0.0f;
+	const uint64 StartCycles = bUseBudget ? FPlatformTime::Cycles64() : 0;
+	float DeferrableCostMicroseconds = 0.0f;
+	int32 NumDeferred = 0;
+	int32 NumSleeping = 0;
+	int32 NumMasked = 0;
+	if (bUseBudget) ScheduleDeferrableModifiers();
+
+	{
+		// The pawn may have changed since a pre-update captured, only the batch stepping uses that snapshot
+		FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+		CaptureFrameContext(DeltaTime);
+	}
+	ReadCameraParameters();
+
+	// The batch may already have been stepped by the parallel pre-update this frame
+	const bool bUseBatch = bUseBatchedModifierEvaluation && !ModifierBatch.IsEmpty();
+	if (bUseBatch)
+	{
+		// Gameplay can change the stack after the pre-update, so the order is always checked
+		RefreshBatchOrder();
+		if (BatchAdvancedFrame != FrameContext.FrameNumber)
+		{
+			ModifierBatch.Gather();
+			AdvanceBatch();
+		}
+		else
+		{
+			// Gameplay can write to the modifiers after the pre-update, and those writes still apply this frame.
+			// New or refreshed modifiers haven't been stepped with the latest values, and a step taken with a
+			// different pawn or delta time doesn't match this update, so step the whole batch again.
+			const bool bGatheredChanged = ModifierBatch.Gather();
+			const bool bSnapshotChanged = BatchAdvancedDeltaTime != FrameContext.DeltaTime || BatchAdvancedPawn != FrameContext.Pawn;
+			if (bGatheredChanged || bSnapshotChanged || ModifierBatch.HasChangedSinceAdvance())
+			{
+				ModifierBatch.Rewind();
+				AdvanceBatch();
+			}
+		}
+	}
+
+	StepPackedAlphas(DeltaTime);
+
+	// Alphas are stepped and the budget is scheduled, so it's known which modifiers overwrite their channels this frame
+	FindMaskedModifiers(ECDCameraChannels::Pose, bUseBatch, bUseBudget);
+
+	// The view is kept as a pose for the whole stack and only converted back to rotators at the end,
+	// or when a modifier needs the FMinimalViewInfo
+	FCDCameraPose Pose(InOutPOV);
+	FQuat SourceRotation = Pose.Rotation;
+
+	// Alphas are stepped ahead of the loop, so the ones past a stopping modifier are rewound after it
+	int32 FirstUnreachedIdx = INDEX_NONE;
+	for (int32 ModifierIdx = 0; ModifierIdx < ModifierList.Num(); ++ModifierIdx)
+	{
+		const bool bBatched = bUseBatch && BatchOrder[ModifierIdx].IsValid();
+
+		// Modifiers whose result is overwritten later in the stack only keep their blend and state up to date.
+		// Only instanced modifiers are masked, and the batch still steps the batched ones.
+		if (MaskedModifiers[ModifierIdx])
+		{
+			UCDCameraModifierInstanced* MaskedModifier = static_cast<UCDCameraModifierInstanced*>(ModifierList[ModifierIdx]);
+			if (bBatched) MaskedModifier->MaskedPasses |= ECDCameraChannels::Pose;
+			else MaskedModifier->SkipMasked(ECDCameraChannels::Pose, DeltaTime);
+			++NumMasked;
+			continue;
+		}
+
+		if (bBatched)
+		{
+			UCDCameraModifierInstanced* BatchedModifier = static_cast<UCDCameraModifierInstanced*>(ModifierList[ModifierIdx]);
+			if (BatchedModifier->IsMasked(ECDCameraChannels::Pose))
+			{
+				BatchedModifier->MaskedPasses &= ~ECDCameraChannels::Pose;
+				ModifierBatch.ResumeFromMasked(BatchOrder[ModifierIdx], Pose);
+			}
+			ModifierBatch.Evaluate(BatchOrder[ModifierIdx], DeltaTime, FrameContext.GetPawnVelocity(), Pose);
+			continue;
+		}
+
+		UCameraModifier* Modifier = ModifierList[ModifierIdx];
+		if (Modifier == nullptr || Modifier->IsDisabled()) continue;
+
+		UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
+
+		// A modifier used again after being masked has to be evaluated, its earlier results are stale
+		const bool bResumed = InstancedModifier && InstancedModifier->IsMasked(ECDCameraChannels::Pose);
+		if (bResumed) InstancedModifier->Unmask(ECDCameraChannels::Pose, Pose);
+
+		// Converged modifiers reapply their last change until one of their inputs moves
+		if (InstancedModifier && InstancedModifier->SleepState.bAsleep)
+		{
+			if (!InstancedModifier->ShouldWake(Pose))
+			{
+				InstancedModifier->ApplySleepingPose(DeltaTime, Pose);
+				++NumSleeping;
+				continue;
+			}
+			InstancedModifier->WakeUp();
+		}
+
+		const bool bDeferrable = bUseBudget && InstancedModifier && IsBudgetDeferrable(InstancedModifier);
+		if (bDeferrable && !bResumed && !InstancedModifier->BudgetState.bEvaluateThisFrame)
+		{
+			InstancedModifier->ReuseLastPose(DeltaTime, Pose);
+			++NumDeferred;
+			continue;
+		}
+
+		const FCDCameraPose ViewPose = Pose;
+		const uint64 ModifierStartCycles = bDeferrable ? FPlatformTime::Cycles64() : 0;
+
+		// Same as the base camera manager, a modifier can stop subsequent modifiers from updating
+		bool bStop;
+		if (InstancedModifier && InstancedModifier->GetClass()->HasAnyClassFlags(CLASS_Native))
+		{
+			bStop = InstancedModifier->ModifyCameraPose(DeltaTime, Pose);
+			if (InstancedModifier->CanSleep()) InstancedModifier->TrySleep(ViewPose, Pose);
+		}
+		else
+		{
+			// Blueprint and engine modifiers may implement the Blueprint events or post process, so they get the full view
+			Pose.ApplyTo(InOutPOV, SourceRotation);
+			bStop = Modifier->ModifyCamera(DeltaTime, InOutPOV);
+			Pose = FCDCameraPose(InOutPOV);
+			SourceRotation = Pose.Rotation;
+		}
+
+		if (bDeferrable)
+		{
+			const float CostMicroseconds = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - ModifierStartCycles) * 1000.0);
+			InstancedModifier->BudgetState.Record(ViewPose, Pose, CostMicroseconds);
+			DeferrableCostMicroseconds += CostMicroseconds;
+		}
+		if (bStop)
+		{
+			FirstUnreachedIdx = ModifierIdx + 1;
+			break;
+		}
+	}
+
+	if (FirstUnreachedIdx != INDEX_NONE) RewindUnreachedAlphas(FirstUnreachedIdx, bUseBatch);
+	if (bUseBatch) ModifierBatch.Finish();
+	SET_DWORD_STAT(STAT_Camera_SleepingModifiers, NumSleeping);
+	SET_DWORD_STAT(STAT_Camera_MaskedModifiers, NumMasked);
+
+	Pose.ApplyTo(InOutPOV, SourceRotation);
+
+	if (bUseBudget)
+	{
+		const float FrameMicroseconds = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+		FixedModifierCostMicroseconds = FMath::Max(FrameMicroseconds - DeferrableCostMicroseconds, 0.0f);
+
+		++BudgetStats.FramesMeasured;
+		if (FrameMicroseconds > ModifierBudgetMicroseconds) ++BudgetStats.FramesOverBudget;
+		if (NumDeferred > 0) ++BudgetStats.FramesDegraded;
+		BudgetStats.ModifiersDeferred += NumDeferred;
+		BudgetStats.TotalMicroseconds += FrameMicroseconds;
+		BudgetStats.PeakMicroseconds = FMath::Max(BudgetStats.PeakMicroseconds, FrameMicroseconds);
+		SET_DWORD_STAT(STAT_Camera_DeferredModifiers, NumDeferred);
+	}
+
+	// Alphas are up to date for this frame, so modifiers that have finished blending out can be removed
+	RemoveFinishedModifiers();
+}
+
+void ACDPlayerCameraManager::CaptureFrameContext(float DeltaTime)
+{
+	// Shared by every modifier on this camera, so they don't each query the controller and pawn
+	FrameContext = FCDCameraFrameContext::Capture(PCOwner, DeltaTime, &SocketCache);
+}
+
+void ACDPlayerCameraManager::CapturePreUpdate(float DeltaTime)
+{
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+
+	CaptureFrameContext(DeltaTime);
+	if (!bUseBatchedModifierEvaluation || ModifierBatch.IsEmpty() || BatchAdvancedFrame == FrameContext.FrameNumber) return;
+
+	// Everything read from the modifier objects is read here, the worker only touches the batch's columns
+	ReadCameraParameters();
+	RefreshBatchOrder();
+	ModifierBatch.Gather();
+	BatchGatheredFrame = FrameContext.FrameNumber;
+}
+
+void ACDPlayerCameraManager::PreUpdateCamera()
+{
+	FScopeLock PreUpdateLock(&PreUpdateCriticalSection);
+
+	// Skip if this frame's camera update already ran, or nothing was gathered for it
+	if (!bUseBatchedModifierEvaluation || ModifierBatch.IsEmpty()) return;
+	if (!FrameContext.IsCurrent() || BatchAdvancedFrame == FrameContext.FrameNumber) return;
+	if (BatchGatheredFrame != FrameContext.FrameNumber) return;
+
+	AdvanceBatch();
+}
+
+void ACDPlayerCameraManager::AdvanceBatch()
+{
+	ModifierBatch.Advance(FrameContext.DeltaTime);
+	BatchAdvancedFrame = FrameContext.FrameNumber;
+	BatchAdvancedDeltaTime = FrameContext.DeltaTime;
+	BatchAdvancedPawn = FrameContext.Pawn;
+}
+
+void ACDPlayerCameraManager::RegisterActorTickFunctions(bool bRegister)
+{
+	Super::RegisterActorTickFunctions(bRegister);
+
+	if (bRegister)
+	{
+		if (bPreUpdateAfterPawnMovement && PreUpdateTickFunction.bCanEverTick && CaptureTickFunction.bCanEverTick)
+		{
+			const bool bHasPrerequisite = PreUpdatePrerequisite.IsValid();
+			CaptureTickFunction.Target = this;
+			CaptureTickFunction.SetTickFunctionEnable(bHasPrerequisite);
+			CaptureTickFunction.RegisterTickFunction(GetLevel());
+
+			PreUpdateTickFunction.Target = this;
+			PreUpdateTickFunction.AddPrerequisite(this, CaptureTickFunction);
+			PreUpdateTickFunction.SetTickFunctionEnable(bHasPrerequisite);
+			PreUpdateTickFunction.RegisterTickFunction(GetLevel());
+		}
+	}
+	else
+	{
+		if (PreUpdateTickFunction.IsTickFunctionRegistered()) PreUpdateTickFunction.UnRegisterTickFunction();
+		if (CaptureTickFunction.IsTickFunctionRegistered()) CaptureTickFunction.UnRegisterTickFunction();
+	}
+}
+
+void ACDPlayerCameraManager::UpdatePreUpdatePrerequisite()
+{
+	const APawn* ControlledPawn = PCOwner ? PCOwner->GetPawn() : nullptr;
+	UActorComponent* MovementComponent = ControlledPawn ? ControlledPawn->GetMovementComponent() : nullptr;
+	if (MovementComponent == PreUpdatePrerequisite.Get()) return;
+
+	if (UActorComponent* OldMovementComponent = PreUpdatePrerequisite.Get())
+	{
+		CaptureTickFunction.RemovePrerequisite(OldMovementComponent, OldMovementComponent->PrimaryComponentTick);
+	}
+	if (MovementComponent)
+	{
+		CaptureTickFunction.AddPrerequisite(MovementComponent, MovementComponent->PrimaryComponentTick);
+	}
+	PreUpdatePrerequisite = MovementComponent;
+
+	// Without anything to wait on the capture would run before the pawn moves, so leave the batch to the camera update
+	CaptureTickFunction.SetTickFunctionEnable(MovementComponent != nullptr);
+	PreUpdateTickFunction.SetTickFunctionEnable(MovementComponent != nullptr);
+}
+
+void ACDPlayerCameraManager::RefreshBatchOrder()
+{
+	// Match the batch handles to the current modifier order, this only changes when modifiers are added or removed
+	if (!bBatchOrderDirty && BatchOrder.Num() == ModifierList.Num()) return;
+
+	BatchOrder.Reset(ModifierList.Num());
+	for (const UCameraModifier* Modifier : ModifierList)
+	{
+		BatchOrder.Add(ModifierBatch.FindHandle(Modifier));
+	}
+	bBatchOrderDirty = false;
+}
+
+void ACDPlayerCameraManager::RefreshPackedAlphas()
+{
+	if (!bPackedAlphasDirty) return;
+
+	// Modifiers that left the list were released when they were removed, so only current modifiers are touched here
+	PackedAlphas.Reset();
+	PackedAlphaModifiers.Reset();
+	for (UCameraModifier* Modifier : ModifierList)
+	{
+		UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
+		if (!InstancedModifier) continue;
+
+		// Batched modifiers step their alpha in the batch
+		const bool bBatched = bUseBatchedModifierEvaluation && ModifierBatch.FindHandle(Modifier).IsValid();
+		if (bBatched || !InstancedModifier->UsesPackedAlpha())
+		{
+			ReleasePackedAlpha(InstancedModifier);
+			continue;
+		}
+
+		InstancedModifier->PackedAlphaSlot = PackedAlphaModifiers.Add(InstancedModifier);
+		PackedAlphas.Add(InstancedModifier);
+	}
+	bPackedAlphasDirty = false;
+}
+
+void ACDPlayerCameraManager::StepPackedAlphas(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Camera_StepPackedAlphas);
+
+	RefreshPackedAlphas();
+
+	// Alphas can be set outside of the camera update, so they are gathered rather than kept in the columns
+	const int32 NumModifiers = PackedAlphaModifiers.Num();
+	for (int32 Slot = 0; Slot < NumModifiers; ++Slot)
+	{
+		PackedAlphas.Alpha[Slot] = PackedAlphaModifiers[Slot]->Alpha;
+	}
+
+	PackedAlphas.Step(DeltaTime);
+
+	for (int32 Slot = 0; Slot < NumModifiers; ++Slot)
+	{
+		if (PackedAlphas.bDisabled[Slot]) continue;
+		UCDCameraModifierInstanced* Modifier = PackedAlphaModifiers[Slot];
+		Modifier->SetResolvedAlpha(PackedAlphas.Alpha[Slot], PackedAlphas.BlendedAlpha[Slot]);
+		Modifier->bAlphaSteppedByCamera = true;
+	}
+}
+
+void ACDPlayerCameraManager::RewindUnreachedAlphas(const int32 FirstUnreached, const bool bUseBatch)
+{
+	for (int32 ModifierIdx = FirstUnreached; ModifierIdx < ModifierList.Num(); ++ModifierIdx)
+	{
+		if (bUseBatch && BatchOrder[ModifierIdx].IsValid())
+		{
+			ModifierBatch.RewindSlot(BatchOrder[ModifierIdx]);
+			continue;
+		}
+
+		UCDCameraModifierInstanced* Modifier = Cast<UCDCameraModifierInstanced>(ModifierList[ModifierIdx]);
+		if (!Modifier || !Modifier->bAlphaSteppedByCamera || Modifier->PackedAlphaSlot == INDEX_NONE) continue;
+
+		const int32 Slot = Modifier->PackedAlphaSlot;
+		PackedAlphas.RewindSlot(Slot);
+		Modifier->SetResolvedAlpha(PackedAlphas.Alpha[Slot], PackedAlphas.BlendedAlpha[Slot]);
+		Modifier->bAlphaSteppedByCamera = false;
+	}
+}
+
+void ACDPlayerCameraManager::ReleasePackedAlpha(UCDCameraModifierInstanced* Modifier)
+{
+	if (!Modifier) return;
+	if (Modifier->PackedAlphaSlot != INDEX_NONE) bPackedAlphasDirty = true;
+	Modifier->PackedAlphaSlot = INDEX_NONE;
+	Modifier->bAlphaSteppedByCamera = false;
+}
+
+bool ACDPlayerCameraManager::IsBudgetDeferrable(const UCDCameraModifierInstanced* Modifier) const
+{
+	// Reduced rate modifiers already spread their cost across frames, and rely on their own timer
+	return !Modifier->IsReducedRate() && Modifier->GetCostClass() >= DeferrableCostClass;
+}
+
+void ACDPlayerCameraManager::ScheduleDeferrableModifiers()
+{
+	TArray<UCDCameraModifierInstanced*, TInlineAllocator<16>> Candidates;
+	for (UCameraModifier* Modifier : ModifierList)
+	{
+		UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
+		if (InstancedModifier && !InstancedModifier->IsDisabled() && IsBudgetDeferrable(InstancedModifier))
+		{
+			InstancedModifier->BudgetState.bEvaluateThisFrame = false;
+			Candidates.Add(InstancedModifier);
+		}
+	}
+	if (Candidates.IsEmpty()) return;
+
+	// Modifiers that have waited the longest go first, so expensive modifiers take turns when over budget
+	Algo::StableSort(Candidates, [](const UCDCameraModifierInstanced* A, const UCDCameraModifierInstanced* B)
+	{
+		return A->BudgetState.FramesDeferred > B->BudgetState.FramesDeferred;
+	});
+
+	float RemainingMicroseconds = ModifierBudgetMicroseconds - FixedModifierCostMicroseconds;
+	for (int32 Idx = 0; Idx < Candidates.Num(); ++Idx)
+	{
+		FCDModifierBudgetState& State = Candidates[Idx]->BudgetState;
+
+		// The first modifier always runs, so the budget can't stall every deferrable modifier. Modifiers without an
+		// output to reuse, or that have waited too long, also always run.
+		if (Idx == 0 || !State.bHasOutput || State.FramesDeferred >= MaxDeferredFrames
+			|| State.AverageCostMicroseconds <= RemainingMicroseconds)
+		{
+			State.bEvaluateThisFrame = true;
+			RemainingMicroseconds -= State.AverageCostMicroseconds;
+		}
+	}
+}
+
+void ACDPlayerCameraManager::FindMaskedModifiers(const ECDCameraChannels Pass, const bool bUseBatch, const bool bUseBudget)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Camera_FindMaskedModifiers);
+
+	MaskedModifiers.Init(false, ModifierList.Num());
+	if (!bSkipMaskedModifiers) return;
+
+	// Walk back from the end of the stack, tracking which channels still reach the camera
+	ECDCameraChannels Live = Pass;
+	for (int32 ModifierIdx = ModifierList.Num() - 1; ModifierIdx >= 0; --ModifierIdx)
+	{
+		UCameraModifier* Modifier = ModifierList[ModifierIdx];
+		if (Modifier == nullptr || Modifier->IsDisabled()) continue;
+
+		// Modifiers without a known usage can read anything and stop the modifiers after them, so nothing before them is masked
+		UCDCameraModifierInstanced* InstancedModifier = Cast<UCDCameraModifierInstanced>(Modifier);
+		FCDChannelUsage Usage;
+		if (!InstancedModifier || !InstancedModifier->GetClass()->HasAnyClassFlags(CLASS_Native)
+			|| !InstancedModifier->GetChannelUsage(Usage))
+		{
+			Live = Pass;
+			continue;
+		}
+
+		const ECDCameraChannels Writes = Usage.Writes & Pass;
+		if (Writes == ECDCameraChannels::None) continue;
+
+		if (!EnumHasAnyFlags(Live, Writes))
+		{
+			MaskedModifiers[ModifierIdx] = true;
+			continue;
+		}
+
+		if (IsOverwriting(InstancedModifier, ModifierIdx, Pass, bUseBatch, bUseBudget))
+		{
+			Live &= ~(Usage.Overwrites & Writes);
+		}
+		Live |= Usage.Reads & Pass;
+	}
+}
+
+bool ACDPlayerCameraManager::IsOverwriting(UCDCameraModifierInstanced* Modifier, const int32 ModifierIdx,
+                                           const ECDCameraChannels Pass, const bool bUseBatch, const bool bUseBudget) const
+{
+	// View rotation is blended by the alpha, which isn't stepped by ProcessViewRotation
+	if (Pass == ECDCameraChannels::ViewRotation) return Modifier->GetBlendedAlpha() == 1.0f;
+
+	// The batch has already stepped its alphas this frame
+	if (bUseBatch && BatchOrder[ModifierIdx].IsValid()) return ModifierBatch.IsFullyBlendedIn(BatchOrder[ModifierIdx]);
+
+	// Reduced rate, sleeping and deferred modifiers apply an earlier change on top of the incoming pose
+	if (Modifier->IsReducedRate() || Modifier->SleepState.bAsleep) return false;
+	if (bUseBudget && IsBudgetDeferrable(Modifier) && !Modifier->BudgetState.bEvaluateThisFrame) return false;
+
+	// Alphas the packed pass doesn't step are stepped during evaluation, so they have to be staying at 1 as well
+	if (Modifier->Alpha < 1.0f || Modifier->GetBlendedAlpha() != 1.0f) return false;
+	return Modifier->bAlphaSteppedByCamera || Modifier->GetTargetAlpha() >= 1.0f;
+}
+
+void ACDPlayerCameraManager::GetModifierBudgetStats(int32& FramesMeasured, int32& FramesOverBudget, int32& FramesDegraded,
+                                                    int32& ModifiersDeferred, float& AverageMicroseconds,
+                                                    float& PeakMicroseconds) const
+{
+	FramesMeasured = BudgetStats.FramesMeasured;
+	FramesOverBudget = BudgetStats.FramesOverBudget;
+	FramesDegraded = BudgetStats.FramesDegraded;
+	ModifiersDeferred = BudgetStats.ModifiersDeferred;
+	AverageMicroseconds = BudgetStats.FramesMeasured > 0 ? static_cast<float>(BudgetStats.TotalMicroseconds / BudgetStats.FramesMeasured) : 0.0f;
+	PeakMicroseconds = BudgetStats.PeakMicroseconds;
+}
+
+void ACDPlayerCameraManager::ResetModifierBudgetStats()
+{
+	BudgetStats = FCDModifierBudgetStats();
+}
+
+void ACDPlayerCameraManager::QueueModifierRemoval(UCDCameraModifierInstanced* Modifier)
+{
+	if (IsValid(Modifier)) ModifiersPendingRemoval.AddUnique(Modifier);
+}
+
+void ACDPlayerCameraManager::RemoveFinishedModifiers()
+{
+	if (ModifiersPendingRemoval.IsEmpty()) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_Camera_RemoveFinishedModifiers);
+	for (int32 Idx = ModifiersPendingRemoval.Num() - 1; Idx >= 0; --Idx)
+	{
+		UCDCameraModifierInstanced* Modifier = ModifiersPendingRemoval[Idx];
+
+		// Modifiers that were enabled again since being marked are no longer waiting on removal
+		if (!IsValid(Modifier) || !Modifier->bMarkedForRemoval)
+		{
+			ModifiersPendingRemoval.RemoveAtSwap(Idx, 1, EAllowShrinking::No);
+			continue;
+		}
+		if (Modifier->IsDisabled() || Modifier->Alpha <= 0.0f)
+		{
+			ModifiersPendingRemoval.RemoveAtSwap(Idx, 1, EAllowShrinking::No);
+			Modifier->RemoveSelfFromModifierList();
+		}
+	}
+}
+
+void ACDPlayerCameraManager::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos)
+{
+	// Make sure the modifiers show their current runtime state
+	ModifierBatch.Flush();
+	Super::DisplayDebug(Canvas, DebugDisplay, YL, YPos);
+}
+
+void FCDCameraCaptureTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                               const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (!IsValid(Target) || TickType == LEVELTICK_ViewportsOnly) return;
+
+	// The pawn has finished moving, the pre-update only steps the batch from what is captured here
+	Target->CapturePreUpdate(DeltaTime);
+}
+
+FString FCDCameraCaptureTickFunction::DiagnosticMessage()
+{
+	return Target->GetFullName() + TEXT("[CapturePreUpdate]");
+}
+
+FName FCDCameraCaptureTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("CDCameraCapture"));
+}
+
+void FCDCameraPreUpdateTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                                 const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (!IsValid(Target) || TickType == LEVELTICK_ViewportsOnly) return;
+
+	// Runs after CaptureTickFunction, PreUpdateCamera skips itself if the capture didn't happen this frame
+	Target->PreUpdateCamera();
+}
+
+FString FCDCameraPreUpdateTickFunction::DiagnosticMessage()
+{
+	return Target->GetFullName() + TEXT("[PreUpdateCamera]");
+}
+
+FName FCDCameraPreUpdateTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("CDCameraPreUpdate"));
 }
@@ -48,7 +48,7 @@ FVector UCameraDynamicsFunctionLibrary::BlendVectorsByAxisData(const FVector& A,
 FVector UCameraDynamicsFunctionLibrary::GetOffsetPosition(const FCameraOffsetPositionData& PositionData,
                                                           const FVector& CurrentPosition, const FRotator& CurrentRotation)
 {
-	return PositionData.GetOffsetPosition(CurrentPosition, CurrentRotation);
+	return PositionData.GetOffsetPosition(CurrentPosition, CurrentRotation.Quaternion());
 }
 
 float UCameraDynamicsFunctionLibrary::CameraFInterp(const float& A, const float& B, const float& DeltaTime, const float& InterpSpeed,
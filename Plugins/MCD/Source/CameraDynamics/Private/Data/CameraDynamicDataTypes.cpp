@@ -1,6 +1,7 @@
 ﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
 
 #include "Data/CameraDynamicDataTypes.h"
+#include "CDCameraFrameContext.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Character.h"
 
@@ -21,7 +22,10 @@ FVector FCameraSourcePositionData::FindSourcePosition(const TObjectPtr<APawn> Pa
 	case CDPOS_Socket:
 		if (const ACharacter* OwnerControllerCharacter = Cast<ACharacter>(Pawn))
 		{
-			SourcePosition = OwnerControllerCharacter->GetMesh()->GetSocketLocation(SocketName);
+			if (const USkeletalMeshComponent* Mesh = OwnerControllerCharacter->GetMesh())
+			{
+				SourcePosition = Mesh->GetSocketLocation(SocketName);
+			}
 		}
 		break;
 		
@@ -40,7 +44,28 @@ FVector FCameraSourcePositionData::FindSourcePosition(const TObjectPtr<APawn> Pa
 	return SourcePosition;
 }
 
-FVector FCameraOffsetPositionData::GetOffsetPosition(const FVector& SourcePosition, const FRotator& SourceRotation) const
+FVector FCameraSourcePositionData::FindSourcePosition(const FCDCameraFrameContext& Context) const
+{
+	switch (CameraSourcePosition)
+	{
+	case CDPOS_EyeHeight:
+		return Context.bHasPawn ? Context.PawnEyeLocation : FVector::ZeroVector;
+
+	case CDPOS_Socket:
+		return Context.GetPawnSocketLocation(SocketName);
+
+	case CDPOS_LocalPosition:
+		return LocalPosition + Context.PawnLocation;
+
+	case CDPOS_AbsPosition:
+		return AbsolutePosition;
+
+	default:
+		return FVector::ZeroVector;
+	}
+}
+
+FVector FCameraOffsetPositionData::GetOffsetPosition(const FVector& SourcePosition, const FQuat& SourceRotation) const
 {
 	FVector NewViewLocation = SourcePosition;
 	
@@ -49,7 +74,7 @@ FVector FCameraOffsetPositionData::GetOffsetPosition(const FVector& SourcePositi
 	NewViewLocation += TargetOffset;
 	
 	// Offset the camera by the socket offset, rotated by the target rotation
-	NewViewLocation += FRotationMatrix(SourceRotation).TransformVector(SocketOffset);
+	NewViewLocation += SourceRotation.RotateVector(SocketOffset);
 
 	return NewViewLocation;
 }
@@ -2,6 +2,7 @@
 
 
 #include "Modifiers/CDCameraModifier_FOV_Adjust.h"
+#include "CDCameraKernels.h"
 #include "Engine/Canvas.h"
 #include "Engine/Engine.h"
 
@@ -14,6 +15,7 @@ UCDCameraModifier_FOV_Adjust::UCDCameraModifier_FOV_Adjust()
 	ModificationType = CMO_Absolute;
 	bUseSmoothing = false;
 	SmoothingSpeed = 2.0f;
+	TargetFOVChangeParameter = FCDCameraParameterBinding(CDPARAM_Float);
 	DebugColour = FColor::Turquoise;
 	FriendlyName = FText::FromString(TEXT("FOV Adjustment"));
 }
@@ -26,32 +28,63 @@ void UCDCameraModifier_FOV_Adjust::AddedToCamera(APlayerCameraManager* Camera)
 	FOVChange = TargetFOVChange;
 }
 
-void UCDCameraModifier_FOV_Adjust::ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation,
-                                                       float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifier_FOV_Adjust::GetParameterBindings(TArray<const FCDCameraParameterBinding*>& OutBindings) const
 {
-	Super::ModifyCameraBlended(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
+	Super::GetParameterBindings(OutBindings);
+	OutBindings.Add(&TargetFOVChangeParameter);
+}
+
+void UCDCameraModifier_FOV_Adjust::ReadParameters(const FCDCameraBlackboard& Blackboard)
+{
+	Super::ReadParameters(Blackboard);
+	Blackboard.Read(TargetFOVChangeParameter, TargetFOVChange);
+}
 
-	if (bUseSmoothing)
+bool UCDCameraModifier_FOV_Adjust::HasConverged() const
+{
+	return FMath::IsNearlyEqual(FOVChange, TargetFOVChange, SleepWakeThreshold);
+}
+
+void UCDCameraModifier_FOV_Adjust::GetSleepInputs(FCDSleepInputs& OutInputs) const
+{
+	Super::GetSleepInputs(OutInputs);
+	// Sleeping reapplies the change as an offset, which only holds for additive changes when the incoming FOV moves
+	OutInputs.bFOV |= ModificationType != CMO_Additive;
+	OutInputs.AddValue(TargetFOVChange);
+}
+
+bool UCDCameraModifier_FOV_Adjust::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	OutUsage.Writes = ECDCameraChannels::FOV;
+	if (ModificationType == CMO_Absolute)
 	{
-		FOVChange = FMath::FInterpTo(FOVChange, TargetFOVChange, DeltaTime, SmoothingSpeed);
+		OutUsage.Overwrites = ECDCameraChannels::FOV;
 	}
-	else FOVChange = TargetFOVChange;
+	else
+	{
+		OutUsage.Reads = ECDCameraChannels::FOV;
+	}
+	return true;
+}
+
+void UCDCameraModifier_FOV_Adjust::UpdateMasked(const ECDCameraChannels Pass, const float DeltaTime)
+{
+	Super::UpdateMasked(Pass, DeltaTime);
+	if (Pass != ECDCameraChannels::Pose) return;
+
+	// Smoothing doesn't depend on the camera, so the change keeps moving towards its target
+	FOVChange = CDCameraKernels::StepSmoothedValue(FOVChange, TargetFOVChange, bUseSmoothing, SmoothingSpeed, DeltaTime);
+}
+
+void UCDCameraModifier_FOV_Adjust::ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose)
+{
+	Super::ModifyCameraBlended(DeltaTime, ViewPose, InOutPose);
+
+	FOVChange = CDCameraKernels::StepSmoothedValue(FOVChange, TargetFOVChange, bUseSmoothing, SmoothingSpeed, DeltaTime);
 	
-	switch (ModificationType)	// Apply the FOV change based on the modification type
-    {
-    	case CMO_Absolute:
-    		ChangedFOV = FOVChange;
-    		break;
-    	case CMO_Additive:
-    		ChangedFOV = FOV + FOVChange;
-    		break;
-    	case CMO_Multiplicative:
-    		ChangedFOV = FOV * FOVChange;
-    		break;
-    	default:
-    		break;
-    }
-	NewFOV = ChangedFOV;	// Set the new FOV, ChangedFOV is used as a debug value
+	// Apply the FOV change based on the modification type
+	ChangedFOV = CDCameraKernels::ApplyFOVChange(ViewPose.FOV, FOVChange, ModificationType);
+	InOutPose.FOV = ChangedFOV;	// Set the new FOV, ChangedFOV is used as a debug value
 }
 
 void UCDCameraModifier_FOV_Adjust::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL,
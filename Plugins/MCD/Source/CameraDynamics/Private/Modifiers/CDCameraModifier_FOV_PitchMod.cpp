@@ -2,6 +2,7 @@
 
 
 #include "Modifiers/CDCameraModifier_FOV_PitchMod.h"
+#include "CDCameraKernels.h"
 #include "Engine/Canvas.h"
 #include "Engine/Engine.h"
 
@@ -14,47 +15,40 @@ UCDCameraModifier_FOV_PitchMod::UCDCameraModifier_FOV_PitchMod()
 
 	DebugColour = FColor::Emerald;
 	FriendlyName = FText::FromString(TEXT("Pitch Driven FOV Modifier"));
+	CostClass = CMCC_Curve;
 	InFOV = 0.0f;
 	OutFOV = 0.0f;
 	bWarnedForNonFloatCurve = false;
 }
 
-void UCDCameraModifier_FOV_PitchMod::ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation,
-	float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifier_FOV_PitchMod::ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose)
 {
-	Super::ModifyCameraBlended(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
+	Super::ModifyCameraBlended(DeltaTime, ViewPose, InOutPose);
 
-	InFOV = FOV;
+	InFOV = ViewPose.FOV;
+
+	InOutPose.FOV = CDCameraKernels::ApplyPitchToFOV(InOutPose.FOV, CDCameraKernels::GetViewPitch(InOutPose.Rotation),
+	                                                 GetBakedCurve(PitchToFOVData.Curve), PitchToFOVData.CurveEvaluationType,
+	                                                 bRemapPitch, PitchRange, PitchOutRange);
 	
-	float Pitch = NewViewRotation.Pitch;
+	OutFOV = InOutPose.FOV;
+}
 
-	if (Pitch > 90.0f)
-	{
-		Pitch = 0;
-	}
-	if (bRemapPitch)
+bool UCDCameraModifier_FOV_PitchMod::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	OutUsage.Reads = ECDCameraChannels::Rotation;
+	OutUsage.Writes = ECDCameraChannels::FOV;
+
+	// An absolute curve replaces the incoming FOV
+	if (PitchToFOVData.CurveEvaluationType == ECM_Absolute)
 	{
-		Pitch = FMath::GetMappedRangeValueClamped(PitchRange, PitchOutRange, Pitch);
+		OutUsage.Overwrites = ECDCameraChannels::FOV;
 	}
-	
-	const float EvaluatedCurveValue = PitchToFOVData.Curve.GetRichCurveConst()->Eval(Pitch);
-
-	switch (PitchToFOVData.CurveEvaluationType)
+	else
 	{
-	case ECM_Absolute:
-		NewFOV = EvaluatedCurveValue;
-		break;
-	case ECM_Additive:
-		NewFOV += EvaluatedCurveValue;
-		break;
-	case ECM_Multiplicative:
-		NewFOV *= EvaluatedCurveValue;
-		break;
-	default:
-		break;
+		OutUsage.Reads |= ECDCameraChannels::FOV;
 	}
-	
-	OutFOV = NewFOV;
+	return true;
 }
 
 void UCDCameraModifier_FOV_PitchMod::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL,
@@ -69,3 +63,9 @@ void UCDCameraModifier_FOV_PitchMod::DisplayDebug(UCanvas* Canvas, const FDebugD
 
 	YPos = LineNumber * YL;
 }
+
+void UCDCameraModifier_FOV_PitchMod::GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const
+{
+	Super::GetCurvesToBake(OutCurves);
+	OutCurves.Add(&PitchToFOVData.Curve);
+}
@@ -31,7 +31,8 @@ bool UCDCameraModifier_Follow_VelocityToYaw::ProcessViewRotationBlended(AActor*
 	//---------- Time since last input ----------
 	
 	// Get the time since the last controller input
-	RotationInput = GetOwnerController()->RotationInput;
+	const FCDCameraFrameContext& Frame = GetFrameContext();
+	RotationInput = Frame.RotationInput;
 	if (!RotationInput.IsNearlyZero())
 	{
 		TimeSinceLastInput = 0.0f;
@@ -45,19 +46,18 @@ bool UCDCameraModifier_Follow_VelocityToYaw::ProcessViewRotationBlended(AActor*
 	// Get the interp speed modifier from the time since the last rotation input
 	if (bWaitForNoInput)
 	{
-		TrueInterpSpeed *= GetRuntimeFloatCurveValue(InfluenceTimeSinceInput, TimeSinceLastInput - MinTimeSinceRotationInput);
+		TrueInterpSpeed *= EvalBakedCurve(InfluenceTimeSinceInput, TimeSinceLastInput - MinTimeSinceRotationInput);
 		if (TrueInterpSpeed <= 0.0f) return false;
 	}
 	
-	const APawn* OwnerControlledPawn = GetOwnerControlledPawn();
-	if (!OwnerControlledPawn) return false;
-	PawnVelocityVector = OwnerControlledPawn->GetVelocity() * VelocityScale;
+	if (!Frame.bHasPawn) return false;
+	PawnVelocityVector = Frame.PawnVelocity * VelocityScale;
 	PawnVelocityRotator = PawnVelocityVector.Rotation();
 	
 	// Early return if the velocity is zero
 	if (PawnVelocityVector.IsNearlyZero()) return false;
 	
-	TrueInterpSpeed *= GetRuntimeFloatCurveValue(VelocityYawInfluence, PawnVelocityVector.Length());
+	TrueInterpSpeed *= EvalBakedCurve(VelocityYawInfluence, PawnVelocityVector.Length());
 	if (TrueInterpSpeed <= 0.0f) return false;
 	
 	// Handle the pitch influence
@@ -78,7 +78,7 @@ bool UCDCameraModifier_Follow_VelocityToYaw::ProcessViewRotationBlended(AActor*
 	// Multiply the interp speed the difference in rotation between the current view rotation and the target velocity rotation
 	const float CurrentToTargetDifference = FMath::RadiansToDegrees(
     	FMath::Acos(PawnVelocityRotator.Vector() | OutViewRotation.Vector()));
-	TrueInterpSpeed *= GetRuntimeFloatCurveValue(InfluenceTargetToCurrentDifference, CurrentToTargetDifference);
+	TrueInterpSpeed *= EvalBakedCurve(InfluenceTargetToCurrentDifference, CurrentToTargetDifference);
 	if (TrueInterpSpeed <= 0.0f) return false;
 	
 	// ---------- Perform the interpolation ----------
@@ -88,6 +88,32 @@ bool UCDCameraModifier_Follow_VelocityToYaw::ProcessViewRotationBlended(AActor*
 	return false;
 }
 
+bool UCDCameraModifier_Follow_VelocityToYaw::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	OutUsage.Reads = ECDCameraChannels::ViewRotation;
+	OutUsage.Writes = ECDCameraChannels::ViewRotation;
+	return true;
+}
+
+void UCDCameraModifier_Follow_VelocityToYaw::UpdateMasked(const ECDCameraChannels Pass, const float DeltaTime)
+{
+	Super::UpdateMasked(Pass, DeltaTime);
+	if (Pass != ECDCameraChannels::ViewRotation) return;
+
+	// Keep timing the player's input, so following doesn't kick in early once the modifier is used again
+	RotationInput = GetFrameContext().RotationInput;
+	TimeSinceLastInput = RotationInput.IsNearlyZero() ? TimeSinceLastInput + DeltaTime : 0.0f;
+	TrueInterpSpeed = 0.0f;
+}
+
+void UCDCameraModifier_Follow_VelocityToYaw::ResetForPool()
+{
+	Super::ResetForPool();
+
+	TimeSinceLastInput = 0.0f;
+	TrueInterpSpeed = 0.0f;
+}
+
 void UCDCameraModifier_Follow_VelocityToYaw::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay,
                                                           float& YL, float& YPos)
 {
@@ -123,3 +149,11 @@ void UCDCameraModifier_Follow_VelocityToYaw::DisplayDebug(UCanvas* Canvas, const
 	
 	YPos = LineNumber * YL;
 }
+
+void UCDCameraModifier_Follow_VelocityToYaw::GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const
+{
+	Super::GetCurvesToBake(OutCurves);
+	OutCurves.Add(&InfluenceTimeSinceInput);
+	OutCurves.Add(&InfluenceTargetToCurrentDifference);
+	OutCurves.Add(&VelocityYawInfluence);
+}
@@ -3,6 +3,8 @@
 
 #include "Modifiers/CDCameraModifier_Instanced.h"
 #include "CameraDynamics.h"
+#include "CDBakedCurve.h"
+#include "CDCameraKernels.h"
 #include "CameraDynamicsFunctionLibrary.h"
 #include "CDCameraStack.h"
 #include "CDPlayerCameraManager.h"
@@ -40,13 +42,33 @@ UCDCameraModifierInstanced::UCDCameraModifierInstanced()
 	bBlendOutForViewTargetWithMatchingTag = true;
 	ViewTargetBlendOutTag = FName(TEXT("SequencerActor"));
 	bWatchForViewTargetChange = true;
+	ViewTargetSubscriberIndex = INDEX_NONE;
+
+	UpdateRate = CMUR_EveryFrame;
+	UpdateEveryNFrames = 2;
+	UpdateRateHz = 30.0f;
+	bExtrapolateBetweenUpdates = false;
+	CostClass = CMCC_Math;
+	bAllowSleep = false;
+	SleepWakeThreshold = 0.01f;
+
+	PackedAlphaSlot = INDEX_NONE;
+	bAlphaSteppedByCamera = false;
+	CachedBlendedAlpha = 0.0f;
+	CachedBlendedAlphaSource = -1.0f;
+	bCachedBlendedAlphaBlendIn = true;
+	MaskedPasses = ECDCameraChannels::None;
+	bCurvesBaked = false;
 }
 
 void UCDCameraModifierInstanced::AddedToCamera(APlayerCameraManager* Camera)
 {
 	Super::AddedToCamera(Camera);
+	PoseUpdateTimer.Reset();
+	BudgetState = FCDModifierBudgetState();
+	RefreshBakedCurves();
 	BlueprintAddedToCamera(Camera); // Trigger the blueprint event
-	Cast<ACDPlayerCameraManager>(Camera)->OnViewTargetChangeStart.AddDynamic(this, &UCDCameraModifierInstanced::OnViewTargetChangeStart);
+	Cast<ACDPlayerCameraManager>(Camera)->SubscribeToViewTargetChange(this);
 	EnableModifier();
 }
 
@@ -54,6 +76,25 @@ void UCDCameraModifierInstanced::EnableModifier()
 {
 	Super::EnableModifier();
 	bMarkedForRemoval = false;
+	NotifyBlendStateChanged();
+}
+
+void UCDCameraModifierInstanced::DisableModifier(bool bImmediate)
+{
+	Super::DisableModifier(bImmediate);
+	NotifyBlendStateChanged();
+}
+
+void UCDCameraModifierInstanced::NotifyBlendStateChanged()
+{
+	// The custom blend settings may have changed, so the blended alpha has to be resolved again
+	CachedBlendedAlphaSource = -1.0f;
+
+	// Lets the camera manager refresh any copy of the blend state it keeps for batched evaluation
+	if (ACDPlayerCameraManager* CDCameraManager = Cast<ACDPlayerCameraManager>(CameraOwner))
+	{
+		CDCameraManager->OnModifierBlendStateChanged(this);
+	}
 }
 
 void UCDCameraModifierInstanced::ModifyCamera(float DeltaTime, FVector ViewLocation, FRotator ViewRotation, float FOV,
@@ -61,28 +102,191 @@ void UCDCameraModifierInstanced::ModifyCamera(float DeltaTime, FVector ViewLocat
 {
 	Super::ModifyCamera(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
 
-	const float A = GetCustomBlendAlpha(!bPendingDisable); // Get the alpha for custom blends, if custom blends are enabled
+	// Only used when this modifier isn't run by the camera manager's pose pipeline, such as for Blueprint modifiers
+	FCDCameraPose Pose(NewViewLocation, NewViewRotation.Quaternion(), NewFOV);
+	const FQuat SourceRotation = Pose.Rotation;
+	EvaluatePose(DeltaTime, Pose);
+
+	NewViewLocation = Pose.Location;
+	NewFOV = Pose.FOV;
+	if (!(Pose.Rotation == SourceRotation)) NewViewRotation = Pose.Rotation.Rotator();
+}
+
+bool UCDCameraModifierInstanced::ModifyCameraPose(float DeltaTime, FCDCameraPose& InOutPose)
+{
+	// Same as UCameraModifier::ModifyCamera. Native modifiers don't implement the Blueprint events or post process.
+	UpdateAlpha(DeltaTime);
+	EvaluatePose(DeltaTime, InOutPose);
+
+	// If pending disable and fully alpha'd out, truly disable this modifier
+	if (bPendingDisable && Alpha <= 0.0f) DisableModifier(true);
+
+	// Reset bDrawDebugInfo for next frame
+	bDrawDebugInfoThisFrame = false;
+	return false;
+}
+
+void UCDCameraModifierInstanced::EvaluatePose(float DeltaTime, FCDCameraPose& InOutPose)
+{
+	// Time skipped by the camera manager's frame budget is passed on, so smoothing keeps the same speed
+	DeltaTime += BudgetState.DeferredTime;
+	BudgetState.DeferredTime = 0.0f;
+
+	if (!IsReducedRate())
+	{
+		ModifyPose(DeltaTime, InOutPose);
+		return;
+	}
+
+	if (TickUpdateRate(PoseUpdateTimer, DeltaTime))
+	{
+		const bool bFirstUpdate = !PoseUpdateTimer.bHasUpdated;
+		const FCDCameraPose ViewPose = InOutPose;
+
+		// Pass the whole time since the last evaluation, so smoothing and blending keep the same speed
+		ModifyPose(PoseUpdateTimer.ConsumeUpdate(), InOutPose);
+
+		PreviousPoseDelta = bFirstUpdate ? FCDPoseDelta::Between(ViewPose, InOutPose) : LatestPoseDelta;
+		LatestPoseDelta = FCDPoseDelta::Between(ViewPose, InOutPose);
+
+		// When extrapolating the new result is used as is, when interpolating we're one evaluation behind
+		if (bExtrapolateBetweenUpdates) return;
+		InOutPose = ViewPose;
+		PreviousPoseDelta.ApplyTo(InOutPose);
+		return;
+	}
+
+	const float Fraction = PoseUpdateTimer.GetIntervalFraction();
+	FCDPoseDelta::Interpolate(PreviousPoseDelta, LatestPoseDelta, bExtrapolateBetweenUpdates ? 1.0f + Fraction : Fraction)
+		.ApplyTo(InOutPose);
+}
+
+void UCDCameraModifierInstanced::ReuseLastPose(float DeltaTime, FCDCameraPose& InOutPose)
+{
+	// Keep blending while deferred, so blends take the same time with or without a budget
+	UpdateAlpha(DeltaTime);
+	BudgetState.LastPoseDelta.ApplyTo(InOutPose);
+	BudgetState.DeferredTime += DeltaTime;
+	++BudgetState.FramesDeferred;
+
+	if (bPendingDisable && Alpha <= 0.0f) DisableModifier(true);
+	bDrawDebugInfoThisFrame = false;
+}
+
+bool UCDCameraModifierInstanced::CanSleep() const
+{
+	return bAllowSleep && !IsReducedRate() && GetClass()->HasAnyClassFlags(CLASS_Native);
+}
+
+void UCDCameraModifierInstanced::TrySleep(const FCDCameraPose& ViewPose, const FCDCameraPose& NewPose)
+{
+	// Blending changes the result every frame, so only steady alphas can sleep
+	if (bPendingDisable || bDisabled || Alpha != GetTargetAlpha()) return;
+	if (!HasConverged()) return;
+
+	SleepState.PoseDelta = FCDPoseDelta::Between(ViewPose, NewPose);
+	SleepState.InputPose = ViewPose;
+	SleepState.Inputs = FCDSleepInputs();
+	GetSleepInputs(SleepState.Inputs);
+	SleepState.Alpha = Alpha;
+	SleepState.bAsleep = true;
+	++SleepState.SleepCount;
+}
+
+bool UCDCameraModifierInstanced::ShouldWake(const FCDCameraPose& ViewPose) const
+{
+	if (bPendingDisable || Alpha != SleepState.Alpha) return true;
+
+	const FCDSleepInputs& Inputs = SleepState.Inputs;
+	const FCDCameraPose& InputPose = SleepState.InputPose;
+	if (Inputs.bLocation && FVector::DistSquared(ViewPose.Location, InputPose.Location) > FMath::Square(SleepWakeThreshold)) return true;
+	if (Inputs.bRotation && FMath::RadiansToDegrees(ViewPose.Rotation.AngularDistance(InputPose.Rotation)) > SleepWakeThreshold) return true;
+	if (Inputs.bFOV && FMath::Abs(ViewPose.FOV - InputPose.FOV) > SleepWakeThreshold) return true;
+
+	// Declared values are gathered again, they are usually properties gameplay writes to
+	FCDSleepInputs CurrentInputs;
+	GetSleepInputs(CurrentInputs);
+	if (CurrentInputs.Values.Num() != Inputs.Values.Num()) return true;
+	for (int32 Index = 0; Index < Inputs.Values.Num(); ++Index)
+	{
+		// Flags and targets have no tolerance, so any change wakes the modifier
+		if (FMath::Abs(CurrentInputs.Values[Index] - Inputs.Values[Index]) > Inputs.Tolerances[Index]) return true;
+	}
+	return false;
+}
+
+void UCDCameraModifierInstanced::ApplySleepingPose(float DeltaTime, FCDCameraPose& InOutPose)
+{
+	// The alpha is steady while asleep, but still needs stepping when the camera manager doesn't do it
+	UpdateAlpha(DeltaTime);
+	SleepState.PoseDelta.ApplyTo(InOutPose);
+	bDrawDebugInfoThisFrame = false;
+}
+
+void UCDCameraModifierInstanced::WakeUp()
+{
+	if (!SleepState.bAsleep) return;
+	SleepState.bAsleep = false;
+	++SleepState.WakeCount;
+}
+
+void UCDCameraModifierInstanced::SkipMasked(const ECDCameraChannels Pass, const float DeltaTime)
+{
+	MaskedPasses |= Pass;
+	UpdateMasked(Pass, DeltaTime);
+	if (Pass != ECDCameraChannels::Pose) return;
+
+	// Keep blending while masked, so the alpha is right once the modifiers masking this one blend out
+	UpdateAlpha(DeltaTime);
+	// The change recorded when falling asleep won't match the incoming pose once this modifier is used again
+	WakeUp();
+
+	if (bPendingDisable && Alpha <= 0.0f) DisableModifier(true);
+	bDrawDebugInfoThisFrame = false;
+}
+
+void UCDCameraModifierInstanced::Unmask(const ECDCameraChannels Pass, const FCDCameraPose& ViewPose)
+{
+	MaskedPasses &= ~Pass;
+	if (Pass == ECDCameraChannels::Pose)
+	{
+		// Results from before the modifier was masked are stale, so reduced rate and deferred evaluations start over
+		PoseUpdateTimer.Reset();
+		BudgetState.bHasOutput = false;
+		BudgetState.DeferredTime = 0.0f;
+	}
+	ResumeFromMasked(Pass, ViewPose);
+}
+
+void UCDCameraModifierInstanced::ModifyPose(float DeltaTime, FCDCameraPose& InOutPose)
+{
+	const float A = GetBlendedAlpha(); // Get the alpha for custom blends, if custom blends are enabled
 	
 	if (A == 0.0f) return;
 
+	const FCDCameraPose ViewPose = InOutPose;
+
 	// Native camera modification
-	ModifyCameraBlended(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation,
-		NewViewRotation, NewFOV);
-	// Blueprint camera modification
-	BlueprintModifyCameraBlended(A, DeltaTime, NewViewLocation, NewViewRotation, FOV, NewViewLocation,
-		NewViewRotation, NewFOV);
+	ModifyCameraBlended(DeltaTime, ViewPose, InOutPose);
+
+	// Blueprint camera modification, native classes can't implement it so they skip the FRotator conversion
+	if (!GetClass()->HasAnyClassFlags(CLASS_Native))
+	{
+		const FRotator Rotation = InOutPose.Rotation.Rotator();
+		FRotator NewRotation = Rotation;
+		BlueprintModifyCameraBlended(A, DeltaTime, InOutPose.Location, Rotation, ViewPose.FOV, InOutPose.Location,
+		                             NewRotation, InOutPose.FOV);
+		if (NewRotation != Rotation) InOutPose.Rotation = NewRotation.Quaternion();
+	}
 	
 	// Early return if this modifier is fully active
 	if (A == 1.0f) return;
 
 	// Interpolate the new values with the current values based on the alpha of this modifier
-	NewViewLocation = FMath::Lerp(ViewLocation, NewViewLocation, A);
-	NewViewRotation = FQuat::Slerp(ViewRotation.Quaternion(), NewViewRotation.Quaternion(), A).Rotator();
-	NewFOV = FMath::Lerp(FOV, NewFOV, A);
+	InOutPose = FCDCameraPose::Blend(ViewPose, InOutPose, A);
 }
 
-void UCDCameraModifierInstanced::ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation,
-	float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifierInstanced::ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose)
 {
 }
 
@@ -90,7 +294,7 @@ bool UCDCameraModifierInstanced::ProcessViewRotation(AActor* ViewTarget, float D
 	FRotator& OutDeltaRot)
 {
 	// Get the true alpha value from custom blends, if custom blends are enabled
-	const float A = GetCustomBlendAlpha(!bPendingDisable);
+	const float A = GetBlendedAlpha();
 
 	if (A == 0.0f) return false;
 	
@@ -148,19 +352,17 @@ bool UCDCameraModifierInstanced::ModifyCamera(float DeltaTime, FMinimalViewInfo&
 void UCDCameraModifierInstanced::MarkForRemoval()
 {
 	DisableModifier(false); // Start the blend out process
-	if (!IsValid(CameraOwner))
+	ACDPlayerCameraManager* CDCameraManager = Cast<ACDPlayerCameraManager>(CameraOwner);
+	if (!IsValid(CDCameraManager))
 	{
 		UE_LOG(LogCameraDynamics, Error, TEXT("Camera owner is not valid, cannot mark modifier %s for removal"),
 		       *GetNameSafe(this));
 		return;
 	}
 
-	// If the alpha is already 0.0f, remove the modifier immediately
-	if (AlphaOutTime <= 0.0f) RemoveSelfFromModifierList();
-	
-	GetWorld()->GetTimerManager().SetTimer(RemovalTimerHandle, this,
-	                                       &UCDCameraModifierInstanced::RemoveSelfFromModifierList, AlphaOutTime,
-	                                       false);
+	// The camera manager removes this modifier at the end of its update once the alpha reaches 0.0f
+	bMarkedForRemoval = true;
+	CDCameraManager->QueueModifierRemoval(this);
 }
 
 // Remove the modifier from the camera owner if the owner is valid
@@ -176,36 +378,137 @@ void UCDCameraModifierInstanced::RemoveSelfFromModifierList()
 	CameraOwner->RemoveCameraModifier(this);
 }
 
+void UCDCameraModifierInstanced::RefreshBakedCurves()
+{
+	CachedBlendedAlphaSource = -1.0f;
+
+	// Runtime modifiers share the bakes of the camera data's modifier, which only bakes once
+	UCDCameraModifierInstanced* Source = SourceModifier.Get();
+	if (Source == this) Source = nullptr;
+	if (Source && !Source->bCurvesBaked) Source->RefreshBakedCurves();
+
+	TArray<const FRuntimeFloatCurve*> Curves;
+	GetCurvesToBake(Curves);
+	BakedCurves.Reset();
+	for (const FRuntimeFloatCurve* Curve : Curves)
+	{
+		const FRichCurve* RichCurve = Curve->GetRichCurveConst();
+		if (!RichCurve) continue;
+
+		// Curves changed since the modifier was copied from its source are baked on their own
+		TSharedPtr<const FCDBakedCurve> Baked;
+		if (Source) Baked = Source->FindMatchingBake(*RichCurve);
+		if (!Baked.IsValid()) Baked = FCDBakedCurve::Bake(*RichCurve);
+		BakedCurves.Add({Curve, {RichCurve, MoveTemp(Baked)}});
+	}
+	bCurvesBaked = true;
+
+	// The batch keeps its own references to the curves
+	if (ACDPlayerCameraManager* CDCameraManager = Cast<ACDPlayerCameraManager>(CameraOwner))
+	{
+		CDCameraManager->RefreshBatchedModifier(this);
+	}
+}
+
+FCDCurveRef UCDCameraModifierInstanced::GetBakedCurve(const FRuntimeFloatCurve& Curve) const
+{
+	const FRichCurve* RichCurve = Curve.GetRichCurveConst();
+	for (const FBakedCurveEntry& Entry : BakedCurves)
+	{
+		// The rich curve changes if an external curve is set after baking
+		if (Entry.Source == &Curve && Entry.Curve.Curve == RichCurve) return Entry.Curve;
+	}
+	return {RichCurve, nullptr};
+}
+
+float UCDCameraModifierInstanced::EvalBakedCurve(const FRuntimeFloatCurve& Curve, const float InTime) const
+{
+	const FRichCurve* RichCurve = Curve.GetRichCurveConst();
+	for (const FBakedCurveEntry& Entry : BakedCurves)
+	{
+		if (Entry.Source == &Curve && Entry.Curve.Curve == RichCurve) return Entry.Curve.Eval(InTime);
+	}
+	return RichCurve ? RichCurve->Eval(InTime) : 0.0f;
+}
+
+TSharedPtr<const FCDBakedCurve> UCDCameraModifierInstanced::FindMatchingBake(const FRichCurve& Curve) const
+{
+	for (const FBakedCurveEntry& Entry : BakedCurves)
+	{
+		if (Entry.Curve.Baked.IsValid() && (Entry.Curve.Curve == &Curve || *Entry.Curve.Curve == Curve)) return Entry.Curve.Baked;
+	}
+	return nullptr;
+}
+
+void UCDCameraModifierInstanced::GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const
+{
+	if (bUseCustomBlendIn) OutCurves.Add(&CustomBlendIn);
+	if (bUseCustomBlendOut) OutCurves.Add(&CustomBlendOut);
+}
+
+bool UCDCameraModifierInstanced::HasParameterBindings() const
+{
+	TArray<const FCDCameraParameterBinding*> Bindings;
+	GetParameterBindings(Bindings);
+	return Bindings.ContainsByPredicate([](const FCDCameraParameterBinding* Binding) { return !Binding->Parameter.IsNone(); });
+}
+
+void UCDCameraModifierInstanced::ResetForPool()
+{
+	BakedCurves.Reset();
+	bCurvesBaked = false;
+	PackedAlphaSlot = INDEX_NONE;
+	bAlphaSteppedByCamera = false;
+	CachedBlendedAlphaSource = -1.0f;
+	SleepState = FCDModifierSleepState();
+	MaskedPasses = ECDCameraChannels::None;
+
+	if (ACDPlayerCameraManager* CDCameraManager = Cast<ACDPlayerCameraManager>(CameraOwner))
+	{
+		CDCameraManager->UnsubscribeFromViewTargetChange(this);
+	}
+
+	Alpha = 0.0f;
+	bDisabled = true;
+	bPendingDisable = false;
+	bDrawDebugInfoThisFrame = false;
+	bMarkedForRemoval = false;
+	CustomTargetBlendAlpha = -1.0f;
+	CustomTargetBlendTime = -1.0f;
+	AlphaBeforeViewTargetTagBlendOut = -1.0f;
+	CameraDataSource = nullptr;
+	CameraDataHandle.Invalidate();
+}
+
 void UCDCameraModifierInstanced::BlendToNewTargetAlpha(float NewTargetAlpha, float BlendTime)
 {
 	if (bPendingDisable) return;	// Don't use custom blends if we're pending disable
 	CustomTargetBlendAlpha = NewTargetAlpha;
 	CustomTargetBlendTime = BlendTime;
+	NotifyBlendStateChanged();
 }
 
 void UCDCameraModifierInstanced::ResetBlendState()
 {
 	CustomTargetBlendAlpha = -1.0f;
 	CustomTargetBlendTime = -1.0f;
+	NotifyBlendStateChanged();
 }
 
-void UCDCameraModifierInstanced::OnViewTargetChangeStart(AActor* NewViewTarget,
-	FViewTargetTransitionParams TransitionParams)
+void UCDCameraModifierInstanced::OnViewTargetChangeStart(const bool bViewTargetHasBlendOutTag, const float BlendTime)
 {
 	// If we're blending from a view target with a matching tag to a view target without a matching tag, blend the alpha back up
-	if (AlphaBeforeViewTargetTagBlendOut >= 0.0f
-		&& !NewViewTarget->ActorHasTag(ViewTargetBlendOutTag)
-		&& AlphaBeforeViewTargetTagBlendOut >= 0.0f)
+	if (AlphaBeforeViewTargetTagBlendOut >= 0.0f && !bViewTargetHasBlendOutTag)
 	{
-		BlendToNewTargetAlpha(AlphaBeforeViewTargetTagBlendOut, TransitionParams.BlendTime);
+		BlendToNewTargetAlpha(AlphaBeforeViewTargetTagBlendOut, BlendTime);
 		AlphaBeforeViewTargetTagBlendOut = -1.0;
 		return;
 	}
 	// If the old view target doesn't have a matching tag and the new one does, blend the alpha down to zero
-	if (NewViewTarget->ActorHasTag(ViewTargetBlendOutTag))
+	if (bViewTargetHasBlendOutTag)
 	{
 		AlphaBeforeViewTargetTagBlendOut = Alpha;
-		BlendToNewTargetAlpha(0.0f, TransitionParams.BlendTime);
+		BlendToNewTargetAlpha(0.0f, BlendTime);
 	}
 }
 
@@ -222,38 +525,46 @@ float UCDCameraModifierInstanced::GetTargetAlpha()
 
 void UCDCameraModifierInstanced::UpdateAlpha(float DeltaTime)
 {
-	float const TargetAlpha = GetTargetAlpha();
-	
-	float BlendTime;
-	// if we have a alternate target time, use that as the new blend time
-	if (CustomTargetBlendTime >= 0.0f) BlendTime = CustomTargetBlendTime;
-	else BlendTime = (TargetAlpha == 0.f) ? AlphaOutTime : AlphaInTime;
-	
-	// no blend time means no blending, just go directly to target alpha
-	if (BlendTime <= 0.f)
-	{
-		Alpha = TargetAlpha;
-	}
-	else if (Alpha > TargetAlpha)
+	// The camera manager's packed alpha pass has already stepped the alpha this frame
+	if (bAlphaSteppedByCamera)
 	{
-		// interpolate downward to target, while protecting against overshooting
-		Alpha = FMath::Max<float>(Alpha - DeltaTime / BlendTime, TargetAlpha);
+		bAlphaSteppedByCamera = false;
+		return;
 	}
-	else
+
+	float const TargetAlpha = GetTargetAlpha();
+	
+	// if we have an alternate target time, use that as the new blend time
+	const float BlendTime = CDCameraKernels::GetBlendTime(TargetAlpha, AlphaInTime, AlphaOutTime, CustomTargetBlendTime);
+	Alpha = CDCameraKernels::StepAlpha(Alpha, TargetAlpha, BlendTime, DeltaTime);
+}
+
+float UCDCameraModifierInstanced::GetCustomBlendAlpha(bool bBlendIn) const
+{
+	// Return the alpha value from the appropriate custom blend curve, if we're using custom blending for the blend type
+	return CDCameraKernels::ResolveCustomBlendAlpha(Alpha, bBlendIn, AlphaInTime, AlphaOutTime,
+	                                                bUseCustomBlendIn ? GetBakedCurve(CustomBlendIn) : FCDCurveRef(),
+	                                                bUseCustomBlendOut ? GetBakedCurve(CustomBlendOut) : FCDCurveRef());
+}
+
+float UCDCameraModifierInstanced::GetBlendedAlpha() const
+{
+	const bool bBlendIn = !bPendingDisable;
+	if (Alpha != CachedBlendedAlphaSource || bBlendIn != bCachedBlendedAlphaBlendIn)
 	{
-		// interpolate upward to target, while protecting against overshooting
-		Alpha = FMath::Min<float>(Alpha + DeltaTime / BlendTime, TargetAlpha);
+		CachedBlendedAlpha = GetCustomBlendAlpha(bBlendIn);
+		CachedBlendedAlphaSource = Alpha;
+		bCachedBlendedAlphaBlendIn = bBlendIn;
 	}
+	return CachedBlendedAlpha;
 }
 
-float UCDCameraModifierInstanced::GetCustomBlendAlpha(bool bBlendIn) const
+void UCDCameraModifierInstanced::SetResolvedAlpha(const float NewAlpha, const float NewBlendedAlpha)
 {
-	// Early return alpha if it is fully blended
-	if (Alpha == 0.0f || Alpha == 1.0f) return Alpha;
-	// Return the alpha value from the appropriate custom blend curve
-	if (bBlendIn && bUseCustomBlendIn) return GetRuntimeFloatCurveValue(CustomBlendIn, AlphaInTime);
-	if (bUseCustomBlendOut) return GetRuntimeFloatCurveValue(CustomBlendOut, AlphaOutTime);
-	return Alpha;		// If we're not using custom blending for the blend type, return the alpha value
+	Alpha = NewAlpha;
+	CachedBlendedAlpha = NewBlendedAlpha;
+	CachedBlendedAlphaSource = NewAlpha;
+	bCachedBlendedAlphaBlendIn = !bPendingDisable;
 }
 
 
@@ -272,6 +583,24 @@ void UCDCameraModifierInstanced::DisplayDebug(UCanvas* Canvas, const FDebugDispl
 			TEXT("Modifier_Instanced %s from data %s, Priority %i, Alpha:%f"), *GetNameSafe(this), *DataSourceName, Priority, Alpha), 1 * YL,
 		(LineNumber++) * YL);
 
+	if (IsReducedRate())
+	{
+		const float UpdateHz = PoseUpdateTimer.LastInterval > 0.0f ? 1.0f / PoseUpdateTimer.LastInterval : 0.0f;
+		Canvas->DrawText(DrawFont, FString::Printf(TEXT("Reduced rate, updating at %.1fHz"), UpdateHz), 1 * YL, (LineNumber++) * YL);
+	}
+
+	if (bAllowSleep)
+	{
+		Canvas->DrawText(DrawFont, FString::Printf(TEXT("%s, slept %i times, woken %i times"),
+		                                           SleepState.bAsleep ? TEXT("Asleep") : TEXT("Awake"),
+		                                           SleepState.SleepCount, SleepState.WakeCount), 1 * YL, (LineNumber++) * YL);
+	}
+
+	if (MaskedPasses != ECDCameraChannels::None)
+	{
+		Canvas->DrawText(DrawFont, FString::Printf(TEXT("Skipped, result overwritten by later modifiers")), 1 * YL, (LineNumber++) * YL);
+	}
+
 	if (bMarkedForRemoval)
 	{
 		Canvas->DrawText(DrawFont, FString::Printf(TEXT("Modifier marked for removal, waiting on alpha == 0.0f")), 1 * YL,(LineNumber++) * YL);
@@ -309,6 +638,21 @@ APlayerController* UCDCameraModifierInstanced::GetOwnerController() const
 	return CameraOwner->GetOwningPlayerController();
 }
 
+const FCDCameraFrameContext& UCDCameraModifierInstanced::GetFrameContext() const
+{
+	if (const ACDPlayerCameraManager* CDCameraManager = Cast<ACDPlayerCameraManager>(CameraOwner))
+	{
+		if (CDCameraManager->GetFrameContext().IsCurrent()) return CDCameraManager->GetFrameContext();
+	}
+
+	if (!FallbackFrameContext.IsCurrent())
+	{
+		const UWorld* World = GetWorld();
+		FallbackFrameContext = FCDCameraFrameContext::Capture(GetOwnerController(), World ? World->GetDeltaSeconds() : 0.0f);
+	}
+	return FallbackFrameContext;
+}
+
 FColor UCDCameraModifierInstanced::AdjustColourValue(const int32 ValueOffset, const FColor& InColour)
 {
 	return FColor(
@@ -357,7 +701,8 @@ void UCDCameraModifierInstanced::PostEditChangeChainProperty(FPropertyChangedCha
 	Super::PostEditChangeChainProperty(PropertyChangedEvent);
 
 	UE_LOG(LogTemp, Warning, TEXT("Chain"));
-	CopyPropertiesToRuntimeModifier();
+	RefreshBakedCurves();
+	CopyPropertiesToRuntimeModifiers();
 }
 
 // We use this to copy the properties from the editor to the runtime modifier
@@ -368,13 +713,22 @@ void UCDCameraModifierInstanced::PostEditChangeProperty(FPropertyChangedEvent& P
 }
 
 
-void UCDCameraModifierInstanced::CopyPropertiesToRuntimeModifier()
+void UCDCameraModifierInstanced::CopyPropertiesToRuntimeModifiers()
 {
-	if (!RuntimeModifier.IsValid()) return;
-
 	UEngine::FCopyPropertiesForUnrelatedObjectsParams CopyOptions;
 	CopyOptions.bSkipCompilerGeneratedDefaults = false;
-	UEngine::CopyPropertiesForUnrelatedObjects(this, RuntimeModifier.Get(), CopyOptions);
+
+	// Drop runtime modifiers that have been destroyed, or reused by the pool for a different source
+	EditorRuntimeModifiers.RemoveAllSwap([this](const TWeakObjectPtr<UCDCameraModifierInstanced>& RuntimeModifier)
+	{
+		return !RuntimeModifier.IsValid() || RuntimeModifier->SourceModifier.Get() != this;
+	});
+	for (const TWeakObjectPtr<UCDCameraModifierInstanced>& RuntimeModifier : EditorRuntimeModifiers)
+	{
+		UEngine::CopyPropertiesForUnrelatedObjects(this, RuntimeModifier.Get(), CopyOptions);
+		RuntimeModifier->RefreshBakedCurves();
+		RuntimeModifier->WakeUp();
+	}
 }
 
 #endif
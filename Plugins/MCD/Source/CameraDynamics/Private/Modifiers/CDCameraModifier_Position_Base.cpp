@@ -6,7 +6,6 @@
 #include "DrawDebugHelpers.h"
 #include "Engine/Canvas.h"
 #include "Engine/Engine.h"
-#include "GameFramework/Pawn.h"
 
 UCDCameraModifier_Position_Base::UCDCameraModifier_Position_Base()
 {
@@ -14,21 +13,37 @@ UCDCameraModifier_Position_Base::UCDCameraModifier_Position_Base()
 	FriendlyName = FText::FromString(TEXT("Base Position"));
 }
 
-void UCDCameraModifier_Position_Base::ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation,
-	float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifier_Position_Base::ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose)
 {
-	Super::ModifyCameraBlended(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
+	Super::ModifyCameraBlended(DeltaTime, ViewPose, InOutPose);
 	
-	APawn* OwnerControlledPawn = GetOwnerControlledPawn();
-	if (!IsValid(OwnerControlledPawn)) { return; }
+	const FCDCameraFrameContext& Frame = GetFrameContext();
+	if (!Frame.bHasPawn) { return; }
 	
 	// Get the camera's base position
-	FVector PotentialViewLocation = CameraBasePosition.FindSourcePosition(OwnerControlledPawn);
+	FVector PotentialViewLocation = CameraBasePosition.FindSourcePosition(Frame);
 
 	// Apply axis influence
-	NewViewLocation = AxisInfluence.ProcessAxis(NewViewLocation, PotentialViewLocation);
+	InOutPose.Location = AxisInfluence.ProcessAxis(InOutPose.Location, PotentialViewLocation);
 	
-	CameraInitialPosition = NewViewLocation;
+	CameraInitialPosition = InOutPose.Location;
+}
+
+bool UCDCameraModifier_Position_Base::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	OutUsage.Writes = ECDCameraChannels::Location;
+
+	// With full influence on both axes the incoming location is replaced, unless there's no pawn to take it from
+	const bool bFullInfluence = AxisInfluence.GetXYInfluence() == 1.0f && AxisInfluence.GetZInfluence() == 1.0f;
+	if (bFullInfluence && GetFrameContext().bHasPawn)
+	{
+		OutUsage.Overwrites = ECDCameraChannels::Location;
+	}
+	else
+	{
+		OutUsage.Reads = ECDCameraChannels::Location;
+	}
+	return true;
 }
 
 void UCDCameraModifier_Position_Base::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL,
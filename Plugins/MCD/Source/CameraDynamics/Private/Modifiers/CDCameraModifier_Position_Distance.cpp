@@ -2,6 +2,7 @@
 
 
 #include "Modifiers/CDCameraModifier_Position_Distance.h"
+#include "CDCameraKernels.h"
 
 UCDCameraModifier_Position_Distance::UCDCameraModifier_Position_Distance()
 {
@@ -9,6 +10,7 @@ UCDCameraModifier_Position_Distance::UCDCameraModifier_Position_Distance()
 	Distance = TargetDistance;
 	bSmoothDistanceChanges = false;
 	ChangeSmoothing = 2.0f;
+	TargetDistanceParameter = FCDCameraParameterBinding(CDPARAM_Float);
 	FriendlyName = FText::FromString(TEXT("Forward Distance Offset"));
 }
 
@@ -19,18 +21,55 @@ void UCDCameraModifier_Position_Distance::AddedToCamera(APlayerCameraManager* Ca
 	Distance = TargetDistance;
 }
 
-void UCDCameraModifier_Position_Distance::ModifyCameraBlended(float DeltaTime, FVector ViewLocation,
-                                                              FRotator ViewRotation, float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifier_Position_Distance::GetParameterBindings(TArray<const FCDCameraParameterBinding*>& OutBindings) const
 {
-	Super::ModifyCameraBlended(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
+	Super::GetParameterBindings(OutBindings);
+	OutBindings.Add(&TargetDistanceParameter);
+}
+
+void UCDCameraModifier_Position_Distance::ReadParameters(const FCDCameraBlackboard& Blackboard)
+{
+	Super::ReadParameters(Blackboard);
+	Blackboard.Read(TargetDistanceParameter, TargetDistance);
+}
+
+bool UCDCameraModifier_Position_Distance::HasConverged() const
+{
+	return FMath::IsNearlyEqual(Distance, TargetDistance, SleepWakeThreshold);
+}
+
+void UCDCameraModifier_Position_Distance::GetSleepInputs(FCDSleepInputs& OutInputs) const
+{
+	Super::GetSleepInputs(OutInputs);
+	// The offset is along the incoming rotation
+	OutInputs.bLocation = true;
+	OutInputs.bRotation = true;
+	OutInputs.AddValue(TargetDistance);
+}
+
+bool UCDCameraModifier_Position_Distance::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	OutUsage.Reads = ECDCameraChannels::Location | ECDCameraChannels::Rotation;
+	OutUsage.Writes = ECDCameraChannels::Location;
+	return true;
+}
+
+void UCDCameraModifier_Position_Distance::UpdateMasked(const ECDCameraChannels Pass, const float DeltaTime)
+{
+	Super::UpdateMasked(Pass, DeltaTime);
+	if (Pass != ECDCameraChannels::Pose) return;
+
+	// Smoothing doesn't depend on the camera, so the distance keeps moving towards its target
+	Distance = CDCameraKernels::StepSmoothedValue(Distance, TargetDistance, bSmoothDistanceChanges, ChangeSmoothing, DeltaTime);
+}
+
+void UCDCameraModifier_Position_Distance::ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose)
+{
+	Super::ModifyCameraBlended(DeltaTime, ViewPose, InOutPose);
 
 	// Get the distance
-	if (bSmoothDistanceChanges)
-	{
-		Distance = FMath::FInterpTo(Distance, TargetDistance, DeltaTime, ChangeSmoothing);
-	}
-	else Distance = TargetDistance;
+	Distance = CDCameraKernels::StepSmoothedValue(Distance, TargetDistance, bSmoothDistanceChanges, ChangeSmoothing, DeltaTime);
 	
 	// Offset the camera along the rotation vector by the target distance
-	NewViewLocation = NewViewLocation + NewViewRotation.Vector() * Distance;
+	InOutPose.Location = CDCameraKernels::ApplyForwardDistance(InOutPose.Location, InOutPose.Rotation, Distance);
 }
@@ -3,6 +3,7 @@
 
 #include "Modifiers/CDCameraModifier_Position_DynamicZ.h"
 
+#include "CDCameraKernels.h"
 #include "CameraDynamicsFunctionLibrary.h"
 #include "DrawDebugHelpers.h"
 #include "Camera/PlayerCameraManager.h"
@@ -19,6 +20,7 @@ UCDCameraModifier_Position_DynamicZ::UCDCameraModifier_Position_DynamicZ()
 	bShouldDirectInterpZ = false;
 	DebugColour = FColor::Purple;
 	FriendlyName = FText::FromString(TEXT("Dynamic Z Position"));
+	CostClass = CMCC_Curve;
 }
 
 
@@ -55,49 +57,26 @@ void UCDCameraModifier_Position_DynamicZ::OnCharacterLanded(const FHitResult& Hi
 	bShouldDirectInterpZ = true;
 }
 
-void UCDCameraModifier_Position_DynamicZ::ModifyCameraBlended(float DeltaTime, FVector ViewLocation,
-	FRotator ViewRotation, float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifier_Position_DynamicZ::ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose)
 {
-	Super::ModifyCameraBlended(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
+	Super::ModifyCameraBlended(DeltaTime, ViewPose, InOutPose);
 
-	TargetPosition = NewViewLocation;
+	TargetPosition = InOutPose.Location;
 	
-	UCharacterMovementComponent* CharacterMovement;
-	if (!IsValid(GetOwnerControlledCharacter())) return;
-	if (!IsValid(CharacterMovement = GetOwnerControlledCharacter()->GetCharacterMovement())) return;
-	
-	// If we are grounded
-	if (CharacterMovement->IsMovingOnGround())
-	{
-		// Check if the camera is already at target
-		if (bShouldDirectInterpZ)
-		{
-			if (FMath::IsNearlyEqual(CurrentPosition.Z, NewViewLocation.Z,0.1f))
-			{
-				bShouldDirectInterpZ = false;
-			}
-			else
-			{
-				const float DirectInterp = GetRuntimeFloatCurveValue(ReturnSpeed, FMath::Abs(CurrentPosition.Z - NewViewLocation.Z));
-				NewViewLocation.Z = UCameraDynamicsFunctionLibrary::CameraFInterp(
-					CurrentPosition.Z, NewViewLocation.Z, DeltaTime, DirectInterp, false, -1.0f, SnapThreshold);
-			}
-		}
-		CurrentPosition = NewViewLocation;
-		LastGroundedPosition = NewViewLocation;
-		return;
-	}
-	
-	// Evaluate the interp speed if we're not grounded
-	LastGroundedPosition.X = NewViewLocation.X;
-	LastGroundedPosition.Y = NewViewLocation.Y;
-	
-	const float DistanceFromLastGrounded = NewViewLocation.Z - LastGroundedPosition.Z;
-	const float ZInterp = GetRuntimeFloatCurveValue(AirborneInterpSpeed, DistanceFromLastGrounded);
-	NewViewLocation.Z = UCameraDynamicsFunctionLibrary::CameraFInterp(CurrentPosition.Z, NewViewLocation.Z, DeltaTime, ZInterp, false,
-												  0.0f, SnapThreshold);
-	
-	CurrentPosition = NewViewLocation;
+	const FCDCameraFrameContext& Frame = GetFrameContext();
+	if (!Frame.bHasCharacterMovement) return;
+
+	CDCameraKernels::StepDynamicZ(MakeDynamicZParams(), Frame.bIsMovingOnGround, DeltaTime, InOutPose.Location,
+	                              LastGroundedPosition, CurrentPosition, bShouldDirectInterpZ);
+}
+
+CDCameraKernels::FDynamicZParams UCDCameraModifier_Position_DynamicZ::MakeDynamicZParams() const
+{
+	CDCameraKernels::FDynamicZParams Params;
+	Params.AirborneInterpSpeed = GetBakedCurve(AirborneInterpSpeed);
+	Params.ReturnSpeed = GetBakedCurve(ReturnSpeed);
+	Params.SnapThreshold = SnapThreshold;
+	return Params;
 }
 
 void UCDCameraModifier_Position_DynamicZ::RemoveSelfFromModifierList()
@@ -119,6 +98,13 @@ void UCDCameraModifier_Position_DynamicZ::RemoveSelfFromModifierList()
 	}
 }
 
+void UCDCameraModifier_Position_DynamicZ::ResetForPool()
+{
+	Super::ResetForPool();
+
+	bShouldDirectInterpZ = false;
+}
+
 void UCDCameraModifier_Position_DynamicZ::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay,
 	float& YL, float& YPos)
 {
@@ -142,3 +128,46 @@ void UCDCameraModifier_Position_DynamicZ::DisplayDebug(UCanvas* Canvas, const FD
 	
 	YPos = LineNumber * YL;
 }
+
+void UCDCameraModifier_Position_DynamicZ::GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const
+{
+	Super::GetCurvesToBake(OutCurves);
+	OutCurves.Add(&AirborneInterpSpeed);
+	OutCurves.Add(&ReturnSpeed);
+}
+
+bool UCDCameraModifier_Position_DynamicZ::HasConverged() const
+{
+	// Grounded and back at the target height, the camera height follows the pawn exactly
+	const FCDCameraFrameContext& Frame = GetFrameContext();
+	return !Frame.bHasCharacterMovement || (Frame.bIsMovingOnGround && !bShouldDirectInterpZ);
+}
+
+void UCDCameraModifier_Position_DynamicZ::GetSleepInputs(FCDSleepInputs& OutInputs) const
+{
+	Super::GetSleepInputs(OutInputs);
+	OutInputs.bLocation = true;
+	const FCDCameraFrameContext& Frame = GetFrameContext();
+	OutInputs.AddFlag(Frame.bHasCharacterMovement);
+	OutInputs.AddFlag(Frame.bIsMovingOnGround);
+	// Set by the landed event
+	OutInputs.AddFlag(bShouldDirectInterpZ);
+}
+
+bool UCDCameraModifier_Position_DynamicZ::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	OutUsage.Reads = ECDCameraChannels::Location;
+	OutUsage.Writes = ECDCameraChannels::Location;
+	return true;
+}
+
+void UCDCameraModifier_Position_DynamicZ::ResumeFromMasked(const ECDCameraChannels Pass, const FCDCameraPose& ViewPose)
+{
+	Super::ResumeFromMasked(Pass, ViewPose);
+	if (Pass != ECDCameraChannels::Pose) return;
+
+	// Same as when the modifier is added, the incoming location stands in for the last grounded one
+	LastGroundedPosition = ViewPose.Location;
+	CurrentPosition = ViewPose.Location;
+	bShouldDirectInterpZ = false;
+}
@@ -26,6 +26,7 @@ UCDCameraModifier_Position_Lag::UCDCameraModifier_Position_Lag()
 	DebugColour = FColor(200, 200, 200, 255);
 	DebugTextBaseOffset = FVector2D(150.0f, 25.0f);
 	FriendlyName = FText::FromString(TEXT("Position Lag"));
+	CostClass = CMCC_Curve;
 }
 
 void UCDCameraModifier_Position_Lag::AddedToCamera(APlayerCameraManager* Camera)
@@ -34,72 +35,37 @@ void UCDCameraModifier_Position_Lag::AddedToCamera(APlayerCameraManager* Camera)
 
 	CameraPositionTarget = Camera->GetCameraLocation();
 	LaggedCameraPosition = CameraPositionTarget;
-	LastFrameRotation = Camera->GetCameraRotation();
+	LastFrameRotation = Camera->GetCameraRotation().Quaternion();
 }
 
-void UCDCameraModifier_Position_Lag::ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation,
-	float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifier_Position_Lag::ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose)
 {
-	Super::ModifyCameraBlended(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
+	Super::ModifyCameraBlended(DeltaTime, ViewPose, InOutPose);
 	
-	CameraPositionTarget = ViewLocation;
-	InterpSpeed = InterpSpeedMod;
-
-	/* Find distance between the previous frame's lagged position and the current frame's position target
-	in order to evaluate the interp speed curve */
-	if (bUseInterpSpeedCurve)
-	{
-		FVector DistanceCalcPosition = CameraPositionTarget;
-		// Calculate the distance
-		DistanceCalcPosition = AxisInfluence.ProcessAxis(LaggedCameraPosition, DistanceCalcPosition);
-		
-		DistanceToTarget = FVector::Distance(LaggedCameraPosition, DistanceCalcPosition);
-		InterpSpeed *= InterpSpeedCurve.GetRichCurveConst()->Eval(DistanceToTarget);
-	}
-
-	// Add the delta rotation to the interp speed, if applicable
-	if (bAddDeltaRotationToInterpSpeed)
-	{
-		float RotInterpSpedScale = DeltaRotationToInterpSpeedScale;
-		if (bVelocityInfluencesRotInterpSpeed)
-		{
-			if (const APawn* OwnerPawn = GetOwnerControlledPawn(); IsValid(OwnerPawn))
-			{
-				const float Velocity = DeltaYawVelocityAxisInfluence.ProcessAxis(FVector::ZeroVector, OwnerPawn->GetVelocity()).Length();
-				RotInterpSpedScale *= GetRuntimeFloatCurveValue(DeltaYawVelocityInfluenceCurve, Velocity);
-			}
-		}
-		const float DeltaRot = FMath::RadiansToDegrees(FMath::Acos(LastFrameRotation.Vector() | ViewRotation.Vector()));
-		InterpSpeed += DeltaRot * RotInterpSpedScale;
-	}
-	LastFrameRotation = ViewRotation;
-	
-	// If the interp speed is zero, and we don't snap at 0, don't interpolate the camera position
-	if (!(!bZeroValueSnaps && InterpSpeed <= 0.0f))
-	{
-		// Interpolate the camera position
-		LaggedCameraPosition = FMath::VInterpTo(LaggedCameraPosition, CameraPositionTarget, DeltaTime, InterpSpeed);
-	}
-	
-	LaggedCameraPosition.X = FMath::Lerp(CameraPositionTarget.X, LaggedCameraPosition.X, AxisInfluence.GetXYInfluence());
-	LaggedCameraPosition.X = FMath::Lerp(CameraPositionTarget.X, LaggedCameraPosition.X, AxisInfluence.GetXYInfluence());
-	
-	// Apply the axis influence
-	LaggedCameraPosition = AxisInfluence.ProcessAxis(CameraPositionTarget, LaggedCameraPosition);
-
-	// If we are using max distance, clamp the distance to max distance (if the current distance exceeds max distance)
-	// This could run regardless of the distance, but we might want to know if we did clamp the distance or not, for debug or other.
-	if (bUseMaxDistance)
-	{
-		const FVector FromOrigin = CameraPositionTarget - LaggedCameraPosition;
-		if (DistanceToTarget > MaxDistanceBeforeSnap)
-		{
-			const FVector ClampedPositionTarget = CameraPositionTarget + FromOrigin.GetClampedToMaxSize(MaxDistanceBeforeSnap);
-			LaggedCameraPosition = ClampedPositionTarget;
-		}
-	}
-	
-	NewViewLocation = LaggedCameraPosition;
+	CameraPositionTarget = ViewPose.Location;
+
+	// Velocity is only needed if it influences the rotation interp speed
+	const FVector* PawnVelocity = bVelocityInfluencesRotInterpSpeed ? GetFrameContext().GetPawnVelocity() : nullptr;
+
+	InOutPose.Location = CDCameraKernels::StepPositionLag(MakeLagParams(), ViewPose.Location, ViewPose.Rotation,
+	                                                      PawnVelocity, DeltaTime,
+	                                                      LaggedCameraPosition, LastFrameRotation, InterpSpeed, DistanceToTarget);
+}
+
+CDCameraKernels::FLagParams UCDCameraModifier_Position_Lag::MakeLagParams() const
+{
+	CDCameraKernels::FLagParams Params;
+	Params.InterpSpeedMod = InterpSpeedMod;
+	Params.AxisInfluence = AxisInfluence;
+	Params.bUseMaxDistance = bUseMaxDistance;
+	Params.MaxDistanceBeforeSnap = MaxDistanceBeforeSnap;
+	Params.bZeroValueSnaps = bZeroValueSnaps;
+	Params.InterpSpeedCurve = bUseInterpSpeedCurve ? GetBakedCurve(InterpSpeedCurve) : FCDCurveRef();
+	Params.bAddDeltaRotationToInterpSpeed = bAddDeltaRotationToInterpSpeed;
+	Params.DeltaRotationToInterpSpeedScale = DeltaRotationToInterpSpeedScale;
+	Params.DeltaYawVelocityInfluenceCurve = bVelocityInfluencesRotInterpSpeed ? GetBakedCurve(DeltaYawVelocityInfluenceCurve) : FCDCurveRef();
+	Params.DeltaYawVelocityAxisInfluence = DeltaYawVelocityAxisInfluence;
+	return Params;
 }
 
 void UCDCameraModifier_Position_Lag::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL,
@@ -121,3 +87,43 @@ void UCDCameraModifier_Position_Lag::DisplayDebug(UCanvas* Canvas, const FDebugD
 	YPos = LineNumber * YL;
 	
 }
+
+void UCDCameraModifier_Position_Lag::GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const
+{
+	Super::GetCurvesToBake(OutCurves);
+	if (bUseInterpSpeedCurve) OutCurves.Add(&InterpSpeedCurve);
+	if (bVelocityInfluencesRotInterpSpeed) OutCurves.Add(&DeltaYawVelocityInfluenceCurve);
+}
+
+bool UCDCameraModifier_Position_Lag::HasConverged() const
+{
+	// Once caught up, the lagged position follows the target exactly until the target moves
+	return LaggedCameraPosition.Equals(CameraPositionTarget, SleepWakeThreshold);
+}
+
+void UCDCameraModifier_Position_Lag::GetSleepInputs(FCDSleepInputs& OutInputs) const
+{
+	Super::GetSleepInputs(OutInputs);
+	OutInputs.bLocation = true;
+	// Rotation only matters when it speeds up the lag, but it is tracked across frames, so sleeping can't skip it
+	OutInputs.bRotation |= bAddDeltaRotationToInterpSpeed;
+}
+
+bool UCDCameraModifier_Position_Lag::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	OutUsage.Reads = ECDCameraChannels::Location | ECDCameraChannels::Rotation;
+	OutUsage.Writes = ECDCameraChannels::Location;
+	return true;
+}
+
+void UCDCameraModifier_Position_Lag::ResumeFromMasked(const ECDCameraChannels Pass, const FCDCameraPose& ViewPose)
+{
+	Super::ResumeFromMasked(Pass, ViewPose);
+	if (Pass != ECDCameraChannels::Pose) return;
+
+	// Start lagging from the incoming pose, the same as when the modifier is added
+	CameraPositionTarget = ViewPose.Location;
+	LaggedCameraPosition = CameraPositionTarget;
+	LastFrameRotation = ViewPose.Rotation;
+	DistanceToTarget = 0.0f;
+}
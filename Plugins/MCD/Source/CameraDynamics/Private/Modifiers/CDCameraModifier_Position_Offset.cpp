@@ -12,14 +12,21 @@ UCDCameraModifier_Position_Offset::UCDCameraModifier_Position_Offset()
 	FriendlyName = FText::FromString(TEXT("Position Offset"));
 }
 
-void UCDCameraModifier_Position_Offset::ModifyCameraBlended(float DeltaTime, FVector ViewLocation,
-	FRotator ViewRotation, float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifier_Position_Offset::ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose)
 {
-	Super::ModifyCameraBlended(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
+	Super::ModifyCameraBlended(DeltaTime, ViewPose, InOutPose);
 
-	UnmodifiedPosition = ViewLocation;
-    ModifiedPosition = CameraOffsetPosition.GetOffsetPosition(ViewLocation, ViewRotation);
-    NewViewLocation = ModifiedPosition;
+	UnmodifiedPosition = ViewPose.Location;
+    ModifiedPosition = CameraOffsetPosition.GetOffsetPosition(ViewPose.Location, ViewPose.Rotation);
+    InOutPose.Location = ModifiedPosition;
+}
+
+bool UCDCameraModifier_Position_Offset::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	// The socket offset is along the incoming rotation
+	OutUsage.Reads = ECDCameraChannels::Location | ECDCameraChannels::Rotation;
+	OutUsage.Writes = ECDCameraChannels::Location;
+	return true;
 }
 
 void UCDCameraModifier_Position_Offset::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL,
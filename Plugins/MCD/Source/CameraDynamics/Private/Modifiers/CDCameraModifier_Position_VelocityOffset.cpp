@@ -18,23 +18,23 @@ UCDCameraModifier_Position_VelocityOffset::UCDCameraModifier_Position_VelocityOf
 	bUseInterpSpeedCurve = false;
 	DebugColour = FColor::Cyan;
 	FriendlyName = FText::FromString(TEXT("Velocity-Driven Offset"));
+	CostClass = CMCC_Curve;
 }
 
-void UCDCameraModifier_Position_VelocityOffset::ModifyCameraBlended(float DeltaTime, FVector ViewLocation,
-	FRotator ViewRotation, float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifier_Position_VelocityOffset::ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose)
 {
-	Super::ModifyCameraBlended(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
+	Super::ModifyCameraBlended(DeltaTime, ViewPose, InOutPose);
 	
-	UnmodifiedPosition = NewViewLocation;
-	const APawn* OwnerPawn = GetOwnerControlledPawn();
-	if (!IsValid(OwnerPawn)) return;
+	UnmodifiedPosition = InOutPose.Location;
+	const FCDCameraFrameContext& Frame = GetFrameContext();
+	if (!Frame.bHasPawn) return;
 	
 	// Get the target position of the velocity offset, either from the scale or curve
-	FVector PawnVelocity = OwnerPawn->GetVelocity();
+	const FVector& PawnVelocity = Frame.PawnVelocity;
 	
 	if (bUseOffsetCurve)
 	{
-		VelocityOffsetTarget = (PawnVelocity * VelocityOffsetScale).GetSafeNormal() * GetRuntimeFloatCurveValue(
+		VelocityOffsetTarget = (PawnVelocity * VelocityOffsetScale).GetSafeNormal() * EvalBakedCurve(
 			VelocityOffsetCurve, (PawnVelocity * VelocityOffsetScale).Length());
 	}
 	else
@@ -45,24 +45,39 @@ void UCDCameraModifier_Position_VelocityOffset::ModifyCameraBlended(float DeltaT
 	VelocityOffsetTarget *= VelocityOffsetScale;
 	
 	// Make the velocity relative if not in world space
-	if (!bWorldSpace) VelocityOffsetTarget = OwnerPawn->GetActorRotation().UnrotateVector(VelocityOffsetTarget);
+	if (!bWorldSpace) VelocityOffsetTarget = Frame.UnrotateToPawn(VelocityOffsetTarget);
 
 	// Interpolate the velocity offset
 	float InterpSpeed = VelocityOffsetInterpSpeedScale;
 
 	if (bUseInterpSpeedCurve)
 	{
-		InterpSpeed *= InterpSpeedCurve.GetRichCurveConst()->Eval(PawnVelocity.Length());
+		InterpSpeed *= EvalBakedCurve(InterpSpeedCurve, PawnVelocity.Length());
 	}
 	
 	VelocityOffset = FMath::VInterpTo(VelocityOffset, VelocityOffsetTarget, DeltaTime, InterpSpeed);
 	// Re-rotate the velocity if not in world space
 	if (!bWorldSpace)
 	{
-		NewViewLocation += OwnerPawn->GetActorRotation().RotateVector(VelocityOffset);
+		InOutPose.Location += Frame.RotateFromPawn(VelocityOffset);
 		return;
 	}
-	NewViewLocation += VelocityOffset;
+	InOutPose.Location += VelocityOffset;
+}
+
+bool UCDCameraModifier_Position_VelocityOffset::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	OutUsage.Reads = ECDCameraChannels::Location;
+	OutUsage.Writes = ECDCameraChannels::Location;
+	return true;
+}
+
+void UCDCameraModifier_Position_VelocityOffset::ResetForPool()
+{
+	Super::ResetForPool();
+
+	VelocityOffset = FVector::ZeroVector;
+	VelocityOffsetTarget = FVector::ZeroVector;
 }
 
 void UCDCameraModifier_Position_VelocityOffset::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay,
@@ -126,3 +141,10 @@ FVector UCDCameraModifier_Position_VelocityOffset::UnRotateVectorFromActor(const
 	if (!IsValid(InActor)) return FVector::ZeroVector;
 	return InActor->GetActorRotation().UnrotateVector(InVector);
 }
+
+void UCDCameraModifier_Position_VelocityOffset::GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const
+{
+	Super::GetCurvesToBake(OutCurves);
+	if (bUseOffsetCurve) OutCurves.Add(&VelocityOffsetCurve);
+	if (bUseInterpSpeedCurve) OutCurves.Add(&InterpSpeedCurve);
+}
@@ -0,0 +1,127 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "Modifiers/CDCameraModifier_Program.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Program Execute"), STAT_Camera_ProgramExecute, STATGROUP_Game);
+
+UCDCameraModifier_Program::UCDCameraModifier_Program()
+{
+	RunIndex = INDEX_NONE;
+	DebugColour = FColor::Silver;
+	FriendlyName = FText::FromString(TEXT("Compiled Program"));
+}
+
+void UCDCameraModifier_Program::InitializeProgram(const TSharedRef<const FCDCameraProgram>& InProgram, const int32 InRunIndex,
+                                                  const UCDCameraModifierInstanced* FirstSourceModifier)
+{
+	Program = InProgram;
+	RunIndex = InRunIndex;
+
+	// The longest blend of the run, so this modifier is only disabled once every compiled modifier has blended out
+	const FCDCameraProgramRun& Run = Program->Runs[RunIndex];
+	AlphaInTime = 0.0f;
+	AlphaOutTime = 0.0f;
+	CostClass = CMCC_Math;
+	for (int32 Index = 0; Index < Run.NumOps; ++Index)
+	{
+		AlphaInTime = FMath::Max(AlphaInTime, Program->Blends[Run.FirstOp + Index].AlphaInTime);
+		AlphaOutTime = FMath::Max(AlphaOutTime, Program->Blends[Run.FirstOp + Index].AlphaOutTime);
+
+		// The run costs as much as its most expensive op
+		switch (Program->Ops[Run.FirstOp + Index].OpCode)
+		{
+		case ECDCameraOpCode::SweepBasic:
+			CostClass = CMCC_WorldQuery;
+			break;
+		case ECDCameraOpCode::PositionLag:
+		case ECDCameraOpCode::PositionDynamicZ:
+		case ECDCameraOpCode::FOVPitchMod:
+			if (CostClass < CMCC_Curve) CostClass = CMCC_Curve;
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Every modifier in a run shares these, see FCDCameraProgram::Compile
+	if (IsValid(FirstSourceModifier))
+	{
+		bBlendOutForViewTargetWithMatchingTag = FirstSourceModifier->bBlendOutForViewTargetWithMatchingTag;
+		ViewTargetBlendOutTag = FirstSourceModifier->ViewTargetBlendOutTag;
+		bWatchForViewTargetChange = FirstSourceModifier->bWatchForViewTargetChange;
+	}
+	FriendlyName = FText::FromString(FString::Printf(TEXT("Compiled Program (%i modifiers)"), Run.NumOps));
+}
+
+void UCDCameraModifier_Program::AddedToCamera(APlayerCameraManager* Camera)
+{
+	Super::AddedToCamera(Camera);
+
+	if (Program.IsValid())
+	{
+		Program->InitializeState(RunIndex, State, Camera->GetCameraLocation(), Camera->GetCameraRotation().Quaternion());
+	}
+}
+
+void UCDCameraModifier_Program::UpdateAlpha(float DeltaTime)
+{
+	Super::UpdateAlpha(DeltaTime);
+
+	if (Program.IsValid())
+	{
+		Program->UpdateAlpha(RunIndex, State, GetTargetAlpha(), GetCustomTargetBlendTime(), DeltaTime);
+	}
+}
+
+void UCDCameraModifier_Program::ModifyPose(float DeltaTime, FCDCameraPose& InOutPose)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Camera_ProgramExecute);
+	if (!Program.IsValid()) return;
+
+	Program->Execute(RunIndex, State, MakeContext(DeltaTime), InOutPose);
+}
+
+bool UCDCameraModifier_Program::ProcessViewRotation(AActor* ViewTarget, float DeltaTime, FRotator& OutViewRotation,
+                                                    FRotator& OutDeltaRot)
+{
+	if (!Program.IsValid()) return false;
+
+	return Program->ExecuteViewRotation(RunIndex, State, MakeContext(DeltaTime), OutViewRotation, OutDeltaRot);
+}
+
+FCDCameraProgramContext UCDCameraModifier_Program::MakeContext(const float DeltaTime) const
+{
+	FCDCameraProgramContext Context;
+	Context.World = GetWorld();
+	Context.Frame = &GetFrameContext();
+	Context.CameraLocation = IsValid(CameraOwner) ? CameraOwner->GetCameraLocation() : FVector::ZeroVector;
+	Context.DeltaTime = DeltaTime;
+	Context.bBlendIn = !bPendingDisable;
+	return Context;
+}
+
+void UCDCameraModifier_Program::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos)
+{
+	Super::DisplayDebug(Canvas, DebugDisplay, YL, YPos);
+	if (!Program.IsValid()) return;
+
+	const UFont* DrawFont = GEngine->GetSmallFont();
+	int LineNumber = FMath::CeilToInt(YPos / YL);
+	Canvas->SetDrawColor(DebugColour);
+
+	const FCDCameraProgramRun& Run = Program->Runs[RunIndex];
+	for (int32 Index = 0; Index < Run.NumOps; ++Index)
+	{
+		const FCDCameraOp& Op = Program->Ops[Run.FirstOp + Index];
+		Canvas->DrawText(DrawFont, FString::Printf(TEXT("%i : %s, Alpha:%f"), Op.SourceIndex,
+		                                           FCDCameraProgram::GetOpCodeName(Op.OpCode), State.Alpha[Index]),
+		                 2 * YL, (LineNumber++) * YL);
+	}
+
+	YPos = LineNumber * YL;
+}
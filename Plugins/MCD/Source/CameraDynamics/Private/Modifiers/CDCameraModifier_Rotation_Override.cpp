@@ -14,44 +14,110 @@ UCDCameraModifier_Rotation_Override::UCDCameraModifier_Rotation_Override()
 	RotationOverrideType = CAMROT_None;
 	LookAtActor = nullptr;
 	LookAtComponent = nullptr;
+	RotationOverrideParameter = FCDCameraParameterBinding(CDPARAM_Rotator);
+	LookAtLocationParameter = FCDCameraParameterBinding(CDPARAM_Vector);
+	LookAtActorParameter = FCDCameraParameterBinding(CDPARAM_Object);
 	
 	DebugColour = FColor::Black;
 	FriendlyName = FText::FromString(TEXT("Rotation Override"));
 }
 
+void UCDCameraModifier_Rotation_Override::AddedToCamera(APlayerCameraManager* Camera)
+{
+	Super::AddedToCamera(Camera);
+	TargetUpdateTimer.Reset();
+}
+
+void UCDCameraModifier_Rotation_Override::GetParameterBindings(TArray<const FCDCameraParameterBinding*>& OutBindings) const
+{
+	Super::GetParameterBindings(OutBindings);
+	OutBindings.Add(&RotationOverrideParameter);
+	OutBindings.Add(&LookAtLocationParameter);
+	OutBindings.Add(&LookAtActorParameter);
+}
+
+void UCDCameraModifier_Rotation_Override::ReadParameters(const FCDCameraBlackboard& Blackboard)
+{
+	Super::ReadParameters(Blackboard);
+	Blackboard.Read(RotationOverrideParameter, RotationOverride);
+	Blackboard.Read(LookAtLocationParameter, LookAtLocation);
+	Blackboard.Read(LookAtActorParameter, LookAtActor);
+}
+
 bool UCDCameraModifier_Rotation_Override::ProcessViewRotationBlended(AActor* ViewTarget, float DeltaTime,
                                                                      FRotator& OutViewRotation, FRotator& OutDeltaRot)
 {
-	FRotator TargetRotation = FRotator::ZeroRotator;
-	FRotator TargetDeltaRotation = FRotator::ZeroRotator;
+	if (RotationOverrideType == CAMROT_None) return false;
 
+	OutViewRotation = IsReducedRate() ? GetReducedRateTargetRotation(DeltaTime) : SolveTargetRotation();
+	OutDeltaRot = FRotator::ZeroRotator;
+	return false;
+}
+
+bool UCDCameraModifier_Rotation_Override::GetChannelUsage(FCDChannelUsage& OutUsage) const
+{
+	// Every override type replaces the view and delta rotation. Look at overrides use last frame's camera location,
+	// which isn't affected by this frame's modifiers.
+	if (RotationOverrideType != CAMROT_None)
+	{
+		OutUsage.Writes = ECDCameraChannels::ViewRotation;
+		OutUsage.Overwrites = ECDCameraChannels::ViewRotation;
+	}
+	return true;
+}
+
+void UCDCameraModifier_Rotation_Override::ResumeFromMasked(const ECDCameraChannels Pass, const FCDCameraPose& ViewPose)
+{
+	Super::ResumeFromMasked(Pass, ViewPose);
+
+	// Solve again straight away, instead of interpolating from targets solved before the modifier was masked
+	if (Pass == ECDCameraChannels::ViewRotation) TargetUpdateTimer.Reset();
+}
+
+FRotator UCDCameraModifier_Rotation_Override::SolveTargetRotation() const
+{
 	switch (RotationOverrideType)
 	{
 		case CAMROT_Absolute:
-			TargetRotation = RotationOverride;
-			break;
+			return RotationOverride;
 		case CAMROT_LookAtLocation:
-			TargetRotation = (LookAtLocation - CameraOwner->GetCameraLocation()).Rotation();
-			break;
+			return (LookAtLocation - CameraOwner->GetCameraLocation()).Rotation();
 		case CAMROT_LookAtActor:
 			if (IsValid(LookAtActor))
 			{
-				TargetRotation = (LookAtActor->GetActorLocation() - CameraOwner->GetCameraLocation()).Rotation();
+				return (LookAtActor->GetActorLocation() - CameraOwner->GetCameraLocation()).Rotation();
 			}
 			break;
 		case CAMROT_SceneComponent:
 			if (IsValid(LookAtComponent))
 			{
-				TargetRotation = (LookAtComponent->GetComponentLocation() - CameraOwner->GetCameraLocation()).Rotation();
+				return (LookAtComponent->GetComponentLocation() - CameraOwner->GetCameraLocation()).Rotation();
 			}
 			break;
 		default:
-			return false;
+			break;
 	}
-	
-	OutViewRotation = TargetRotation;
-	OutDeltaRot = TargetDeltaRotation;
-	return false;
+	return FRotator::ZeroRotator;
+}
+
+FRotator UCDCameraModifier_Rotation_Override::GetReducedRateTargetRotation(const float DeltaTime)
+{
+	if (TickUpdateRate(TargetUpdateTimer, DeltaTime))
+	{
+		const bool bFirstUpdate = !TargetUpdateTimer.bHasUpdated;
+		TargetUpdateTimer.ConsumeUpdate();
+
+		const FQuat SolvedRotation = SolveTargetRotation().Quaternion();
+		PreviousTargetRotation = bFirstUpdate ? SolvedRotation : LatestTargetRotation;
+		LatestTargetRotation = SolvedRotation;
+
+		// When extrapolating the new solve is used as is, when interpolating we're one solve behind
+		return (bExtrapolateBetweenUpdates ? LatestTargetRotation : PreviousTargetRotation).Rotator();
+	}
+
+	const float Fraction = TargetUpdateTimer.GetIntervalFraction();
+	return FCDCameraPose::InterpolateRotation(PreviousTargetRotation, LatestTargetRotation,
+	                                          bExtrapolateBetweenUpdates ? 1.0f + Fraction : Fraction).Rotator();
 }
 
 void UCDCameraModifier_Rotation_Override::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay,
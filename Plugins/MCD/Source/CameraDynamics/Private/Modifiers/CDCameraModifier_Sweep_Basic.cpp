@@ -2,9 +2,7 @@
 
 
 #include "Modifiers/CDCameraModifier_Sweep_Basic.h"
-#include "CollisionQueryParams.h"
 #include "DrawDebugHelpers.h"
-#include "Runtime/Engine/Classes/Engine/HitResult.h"
 #include "Engine/Canvas.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
@@ -14,33 +12,155 @@ UCDCameraModifier_Sweep_Basic::UCDCameraModifier_Sweep_Basic()
 {
 	DebugColour = FColor::Red;
 	FriendlyName = FText::FromString(TEXT("Basic Collision Trace"));
+	CostClass = CMCC_WorldQuery;
+
+	bUseAsyncSweep = false;
+	MaxAsyncTraceMovement = 50.0f;
+	bHasAsyncResult = false;
+	SyncFallbacks = 0;
+
+	bUseSweepCache = false;
+	SweepCacheTolerance = 1.0f;
+	bCheckDynamicObjectsForCache = true;
+	bHasCachedSweep = false;
+	CachedSweepRadius = 0.0f;
+	CachedSweepChannel = ECC_Camera;
+	SweepCacheQueries = 0;
+	SweepCacheHits = 0;
+}
+
+void UCDCameraModifier_Sweep_Basic::AddedToCamera(APlayerCameraManager* Camera)
+{
+	Super::AddedToCamera(Camera);
+
+	// Results from a previous use of this modifier don't apply
+	PendingTraceHandle.Invalidate();
+	bHasAsyncResult = false;
+	SyncFallbacks = 0;
+	bHasCachedSweep = false;
+	SweepCacheQueries = 0;
+	SweepCacheHits = 0;
 }
 
-void UCDCameraModifier_Sweep_Basic::ModifyCamera(float DeltaTime, FVector ViewLocation, FRotator ViewRotation,
-                                                 float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV)
+void UCDCameraModifier_Sweep_Basic::ModifyPose(float DeltaTime, FCDCameraPose& InOutPose)
 {
-	Super::ModifyCamera(DeltaTime, ViewLocation, ViewRotation, FOV, NewViewLocation, NewViewRotation, NewFOV);
+	Super::ModifyPose(DeltaTime, InOutPose);
+
+	UCDCameraQuerySubsystem* Queries = GetWorld()->GetSubsystem<UCDCameraQuerySubsystem>();
+	if (!Queries) return;
 
 	// Get the trace start point
-	TraceStart = CameraTraceData.TraceStartPoint.FindSourcePosition(GetOwnerControlledPawn());
-	
-	TraceEnd = NewViewLocation;
-	TraceHit = NewViewLocation;	// This gets set here for checking if the trace hit anything in debug drawing
-	FCollisionQueryParams TraceParams;
-	TraceParams.AddIgnoredActor(GetOwnerControlledPawn());
+	const FCDCameraFrameContext& Frame = GetFrameContext();
+	TraceStart = CameraTraceData.TraceStartPoint.FindSourcePosition(Frame);
+	TraceEnd = InOutPose.Location;
+
+	FCDCameraQuery Query;
+	Query.Start = TraceStart;
+	Query.End = TraceEnd;
+	Query.Radius = CameraTraceData.TraceRadius;
+	Query.Channel = CameraTraceData.TraceChannel;
+	Query.IgnoredActor = Frame.Pawn;
 
 	// TODO :: Add additional trace types (object, profile)
 
 	// Promote the trace hit location to the new view location if a hit occurred
-	FHitResult HitResultFromPawn;
-	if (GetWorld()->SweepSingleByChannel(HitResultFromPawn, TraceStart, TraceEnd, FQuat::Identity,
-	                                                           CameraTraceData.TraceChannel, FCollisionShape::MakeSphere(CameraTraceData.TraceRadius),
-	                                                           TraceParams))
+	if (!bUseSweepCache || !TryUseSweepCache(*Queries, Query, TraceHit))
+	{
+		TraceHit = bUseAsyncSweep ? SweepAsync(*Queries, Query) : SweepSync(*Queries, Query);
+	}
+	InOutPose.Location = TraceHit;
+}
+
+FVector UCDCameraModifier_Sweep_Basic::SweepSync(UCDCameraQuerySubsystem& Queries, const FCDCameraQuery& Query)
+{
+	const FCDCameraQueryResult Result = Queries.Sweep(Query);
+
+	bHasCachedSweep = true;
+	CachedSweepResult = Result;
+	CachedSweepRadius = Query.Radius;
+	CachedSweepChannel = Query.Channel;
+	CachedSweepStart = Query.Start;
+	CachedSweepEnd = Query.End;
+
+	return Result.GetLocation(Query.Start, Query.End);
+}
+
+bool UCDCameraModifier_Sweep_Basic::TryUseSweepCache(UCDCameraQuerySubsystem& Queries, const FCDCameraQuery& Query,
+                                                     FVector& OutLocation)
+{
+	SweepCacheQueries++;
+
+	if (!bHasCachedSweep || CachedSweepRadius != Query.Radius || CachedSweepChannel != Query.Channel)
+	{
+		return false;
+	}
+
+	const float ToleranceSquared = FMath::Square(SweepCacheTolerance);
+	if (FVector::DistSquared(Query.Start, CachedSweepStart) > ToleranceSquared
+		|| FVector::DistSquared(Query.End, CachedSweepEnd) > ToleranceSquared)
+	{
+		return false;
+	}
+
+	// Static geometry can't have changed, but something dynamic may have moved into the path of the sweep
+	if (bCheckDynamicObjectsForCache)
+	{
+		FBox SweepBounds(ForceInit);
+		SweepBounds += CachedSweepStart;
+		SweepBounds += CachedSweepEnd;
+		SweepBounds = SweepBounds.ExpandBy(CachedSweepRadius + SweepCacheTolerance);
+		if (GetWorld()->OverlapAnyTestByObjectType(SweepBounds.GetCenter(), FQuat::Identity,
+		                                           FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllDynamicObjects),
+		                                           FCollisionShape::MakeBox(SweepBounds.GetExtent()),
+		                                           Queries.GetQueryParams(Query.IgnoredActor)))
+		{
+			return false;
+		}
+	}
+
+	SweepCacheHits++;
+	OutLocation = CachedSweepResult.GetLocation(Query.Start, Query.End);
+	return true;
+}
+
+void UCDCameraModifier_Sweep_Basic::GetSweepCacheStats(int32& Queries, int32& Hits, float& HitRate) const
+{
+	Queries = SweepCacheQueries;
+	Hits = SweepCacheHits;
+	HitRate = SweepCacheQueries > 0 ? static_cast<float>(SweepCacheHits) / SweepCacheQueries : 0.0f;
+}
+
+FVector UCDCameraModifier_Sweep_Basic::SweepAsync(UCDCameraQuerySubsystem& Queries, const FCDCameraQuery& Query)
+{
+	// Read last frame's sweep. If it isn't ready the previous result is kept.
+	if (Queries.GetAsyncSweepResult(PendingTraceHandle, AsyncResult))
 	{
-		TraceHit = HitResultFromPawn.Location;
+		bHasAsyncResult = true;
+		AsyncResultStart = PendingTraceStart;
+		AsyncResultEnd = PendingTraceEnd;
+		PendingTraceHandle.Invalidate();
 	}
 
-	NewViewLocation = TraceHit;
+	// The result is a fraction along the old trace, so it can be moved along with the camera if it hasn't moved too far
+	FVector Result;
+	const float MaxMovementSquared = FMath::Square(MaxAsyncTraceMovement);
+	if (bHasAsyncResult
+		&& FVector::DistSquared(Query.Start, AsyncResultStart) <= MaxMovementSquared
+		&& FVector::DistSquared(Query.End, AsyncResultEnd) <= MaxMovementSquared)
+	{
+		Result = AsyncResult.GetLocation(Query.Start, Query.End);
+	}
+	else
+	{
+		Result = SweepSync(Queries, Query);
+		SyncFallbacks++;
+	}
+
+	// Issue this frame's sweep, to be read next frame
+	PendingTraceHandle = Queries.RequestAsyncSweep(Query);
+	PendingTraceStart = Query.Start;
+	PendingTraceEnd = Query.End;
+	return Result;
 }
 
 void UCDCameraModifier_Sweep_Basic::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL,
@@ -60,6 +180,17 @@ void UCDCameraModifier_Sweep_Basic::DisplayDebug(UCanvas* Canvas, const FDebugDi
 	DrawDebugCanvasLine(Canvas, TraceStart, TraceHit, FLinearColor::Red);
 	Canvas->SetDrawColor(TraceColor);
 	Canvas->DrawText(DrawFont, FString::Printf(TEXT("Camera trace end/hit location: %s"), *TraceEnd.ToCompactString()), 2 * YL, (LineNumber++) * YL);
+	if (bUseAsyncSweep)
+	{
+		Canvas->DrawText(DrawFont, FString::Printf(TEXT("Async sweep, synchronous fallbacks: %i"), SyncFallbacks), 2 * YL, (LineNumber++) * YL);
+	}
+	if (bUseSweepCache)
+	{
+		int32 Queries, Hits;
+		float HitRate;
+		GetSweepCacheStats(Queries, Hits, HitRate);
+		Canvas->DrawText(DrawFont, FString::Printf(TEXT("Sweep cache: %i / %i hits (%.0f%%)"), Hits, Queries, HitRate * 100.0f), 2 * YL, (LineNumber++) * YL);
+	}
 
 	YPos = LineNumber * YL;
 }
@@ -0,0 +1,239 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+
+#include "Modifiers/CDCameraModifier_Sweep_Predictive.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+UCDCameraModifier_Sweep_Predictive::UCDCameraModifier_Sweep_Predictive()
+{
+	DebugColour = FColor::Orange;
+	FriendlyName = FText::FromString(TEXT("Predictive Collision Trace"));
+	CostClass = CMCC_WorldQuery;
+
+	PredictionTime = 0.25f;
+	bPredictPawnMovement = true;
+	NumWhiskers = 4;
+	WhiskerFanAngle = 30.0f;
+	WhiskerInfluence = 0.5f;
+	ProbesPerFrame = 2;
+	PullInSpeed = 8.0f;
+	ReturnSpeed = 3.0f;
+	MaxProbeMovement = 50.0f;
+
+	NextProbe = 1;
+	CurrentDistance = 0.0f;
+	PredictedDistance = 0.0f;
+	bHasDistance = false;
+	bHasLastTraceEnd = false;
+	SyncFallbacks = 0;
+	ProbesIssued = 0;
+}
+
+void UCDCameraModifier_Sweep_Predictive::AddedToCamera(APlayerCameraManager* Camera)
+{
+	Super::AddedToCamera(Camera);
+
+	// Results from a previous use of this modifier don't apply
+	BuildProbes();
+	bHasDistance = false;
+	bHasLastTraceEnd = false;
+	SyncFallbacks = 0;
+}
+
+void UCDCameraModifier_Sweep_Predictive::BuildProbes()
+{
+	Probes.Reset();
+	Probes.SetNum(2 + NumWhiskers);
+	NextProbe = 1;
+
+	// Whiskers alternate either side of the predicted trace, working outwards
+	const float HalfFan = WhiskerFanAngle * 0.5f;
+	const int32 NumSteps = (NumWhiskers + 1) / 2;
+	for (int32 WhiskerIdx = 0; WhiskerIdx < NumWhiskers; WhiskerIdx++)
+	{
+		const float Side = WhiskerIdx % 2 == 0 ? 1.0f : -1.0f;
+		const float StepAlpha = static_cast<float>(WhiskerIdx / 2 + 1) / NumSteps;
+		FCDSweepProbe& Probe = Probes[2 + WhiskerIdx];
+		Probe.Angle = Side * HalfFan * StepAlpha;
+		Probe.Weight = FMath::Lerp(1.0f, WhiskerInfluence, StepAlpha);
+	}
+}
+
+void UCDCameraModifier_Sweep_Predictive::ModifyPose(float DeltaTime, FCDCameraPose& InOutPose)
+{
+	Super::ModifyPose(DeltaTime, InOutPose);
+
+	if (Probes.Num() != 2 + NumWhiskers)
+	{
+		BuildProbes();
+	}
+
+	UCDCameraQuerySubsystem* Queries = GetWorld()->GetSubsystem<UCDCameraQuerySubsystem>();
+	if (!Queries) return;
+
+	const FCDCameraFrameContext& Frame = GetFrameContext();
+	TraceStart = CameraTraceData.TraceStartPoint.FindSourcePosition(Frame);
+	TraceEnd = InOutPose.Location;
+
+	ReadProbes(*Queries);
+
+	const FVector TraceVector = TraceEnd - TraceStart;
+	const float TraceLength = TraceVector.Length();
+	if (TraceLength <= UE_KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	// Predict where the trace is going to be
+	const FVector CameraVelocity = bHasLastTraceEnd && DeltaTime > 0.0f ? (TraceEnd - LastTraceEnd) / DeltaTime : FVector::ZeroVector;
+	LastTraceEnd = TraceEnd;
+	bHasLastTraceEnd = true;
+
+	PredictedStart = TraceStart;
+	if (bPredictPawnMovement && Frame.bHasPawn)
+	{
+		PredictedStart += Frame.PawnVelocity * PredictionTime;
+	}
+	PredictedEnd = TraceEnd + CameraVelocity * PredictionTime;
+
+	// Fan the whiskers out in the direction the camera is moving, or sideways if it isn't
+	const FVector PredictedDirection = (PredictedEnd - PredictedStart).GetSafeNormal();
+	FanAxis = (PredictedDirection ^ CameraVelocity).GetSafeNormal();
+	if (FanAxis.IsNearlyZero())
+	{
+		FanAxis = FVector::UpVector;
+	}
+
+	// The predicted distance is where the closest weighted hit would put the camera
+	float PredictedFraction = 1.0f;
+	for (int32 ProbeIdx = 1; ProbeIdx < Probes.Num(); ProbeIdx++)
+	{
+		const FCDSweepProbe& Probe = Probes[ProbeIdx];
+		if (Probe.bHasResult && Probe.Result.bHit)
+		{
+			PredictedFraction = FMath::Min(PredictedFraction, FMath::Lerp(1.0f, Probe.Result.Fraction, Probe.Weight));
+		}
+	}
+	PredictedDistance = PredictedFraction * TraceLength;
+
+	if (!bHasDistance)
+	{
+		CurrentDistance = TraceLength;
+		bHasDistance = true;
+	}
+	const float InterpSpeed = PredictedDistance < CurrentDistance ? PullInSpeed : ReturnSpeed;
+	CurrentDistance = FMath::Min(FMath::FInterpTo(CurrentDistance, PredictedDistance, DeltaTime, InterpSpeed), TraceLength);
+
+	// The current trace is a hard limit, the camera can't be further out than it
+	const float CurrentTraceDistance = GetCurrentTraceFraction(*Queries) * TraceLength;
+	CurrentDistance = FMath::Min(CurrentDistance, CurrentTraceDistance);
+	InOutPose.Location = TraceStart + TraceVector / TraceLength * CurrentDistance;
+
+	// Issue this frame's probes together, to be read next frame
+	ProbesIssued = 0;
+	IssueProbe(*Queries, Probes[0], TraceStart, TraceEnd);
+	const int32 NumPredicted = Probes.Num() - 1;
+	for (int32 RefreshIdx = 0; RefreshIdx < FMath::Min(ProbesPerFrame, NumPredicted); RefreshIdx++)
+	{
+		FCDSweepProbe& Probe = Probes[NextProbe];
+		IssueProbe(*Queries, Probe, PredictedStart, GetProbeEnd(PredictedStart, PredictedEnd, FanAxis, Probe.Angle));
+		NextProbe = NextProbe % NumPredicted + 1;
+	}
+}
+
+void UCDCameraModifier_Sweep_Predictive::ReadProbes(const UCDCameraQuerySubsystem& Queries)
+{
+	for (FCDSweepProbe& Probe : Probes)
+	{
+		// If the sweep isn't ready the previous result is kept
+		if (Queries.GetAsyncSweepResult(Probe.PendingHandle, Probe.Result))
+		{
+			Probe.bHasResult = true;
+			Probe.ResultStart = Probe.PendingStart;
+			Probe.ResultEnd = Probe.PendingEnd;
+			Probe.PendingHandle.Invalidate();
+		}
+	}
+}
+
+void UCDCameraModifier_Sweep_Predictive::IssueProbe(UCDCameraQuerySubsystem& Queries, FCDSweepProbe& Probe, const FVector& Start,
+                                                   const FVector& End)
+{
+	// Wait for the previous sweep of this probe rather than issuing another
+	if (Probe.PendingHandle.IsValid())
+	{
+		return;
+	}
+
+	Probe.PendingHandle = Queries.RequestAsyncSweep(MakeQuery(Start, End));
+	Probe.PendingStart = Start;
+	Probe.PendingEnd = End;
+	ProbesIssued++;
+}
+
+float UCDCameraModifier_Sweep_Predictive::GetCurrentTraceFraction(UCDCameraQuerySubsystem& Queries)
+{
+	// The result is a fraction along the old trace, so it can be moved along with the camera if it hasn't moved too far
+	const FCDSweepProbe& CurrentProbe = Probes[0];
+	const float MaxMovementSquared = FMath::Square(MaxProbeMovement);
+	if (CurrentProbe.bHasResult
+		&& FVector::DistSquared(TraceStart, CurrentProbe.ResultStart) <= MaxMovementSquared
+		&& FVector::DistSquared(TraceEnd, CurrentProbe.ResultEnd) <= MaxMovementSquared)
+	{
+		return CurrentProbe.Result.bHit ? CurrentProbe.Result.Fraction : 1.0f;
+	}
+
+	SyncFallbacks++;
+	const FCDCameraQueryResult Result = Queries.Sweep(MakeQuery(TraceStart, TraceEnd));
+	return Result.bHit ? Result.Fraction : 1.0f;
+}
+
+FCDCameraQuery UCDCameraModifier_Sweep_Predictive::MakeQuery(const FVector& Start, const FVector& End) const
+{
+	FCDCameraQuery Query;
+	Query.Start = Start;
+	Query.End = End;
+	Query.Radius = CameraTraceData.TraceRadius;
+	Query.Channel = CameraTraceData.TraceChannel;
+	Query.IgnoredActor = GetFrameContext().Pawn;
+	return Query;
+}
+
+FVector UCDCameraModifier_Sweep_Predictive::GetProbeEnd(const FVector& Start, const FVector& End, const FVector& Axis,
+                                                        const float Angle)
+{
+	return Start + (End - Start).RotateAngleAxis(Angle, Axis);
+}
+
+void UCDCameraModifier_Sweep_Predictive::DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL,
+	float& YPos)
+{
+	Super::DisplayDebug(Canvas, DebugDisplay, YL, YPos);
+
+	const UFont* DrawFont = GEngine->GetSmallFont();
+	int LineNumber = FMath::CeilToInt(YPos / YL);
+
+	DrawDebugCanvasWireSphere(Canvas, TraceStart, FColor::Orange, 10.0f, 16);
+	DrawDebugCanvasLine(Canvas, TraceStart, TraceEnd, FLinearColor::Red);
+	for (int32 ProbeIdx = 1; ProbeIdx < Probes.Num(); ProbeIdx++)
+	{
+		const FCDSweepProbe& Probe = Probes[ProbeIdx];
+		if (Probe.bHasResult)
+		{
+			const FVector HitLocation = Probe.Result.GetLocation(Probe.ResultStart, Probe.ResultEnd);
+			DrawDebugCanvasLine(Canvas, Probe.ResultStart, HitLocation, Probe.Result.bHit ? FLinearColor::Red : FLinearColor::Green);
+		}
+	}
+
+	Canvas->SetDrawColor(FColor::Orange);
+	Canvas->DrawText(DrawFont, FString::Printf(TEXT("Camera trace start: %s"), *TraceStart.ToCompactString()), 2 * YL, (LineNumber++) * YL);
+	Canvas->DrawText(DrawFont, FString::Printf(TEXT("Distance: %.1f, predicted: %.1f"), CurrentDistance, PredictedDistance), 2 * YL, (LineNumber++) * YL);
+	Canvas->DrawText(DrawFont, FString::Printf(TEXT("Probes: %i, issued last frame: %i, synchronous fallbacks: %i"),
+	                                           Probes.Num(), ProbesIssued, SyncFallbacks), 2 * YL, (LineNumber++) * YL);
+
+	YPos = LineNumber * YL;
+}
@@ -0,0 +1,92 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Curves/RichCurve.h"
+#include "Math/Float16.h"
+
+/** Settings used when baking a curve */
+struct FCDCurveBakeSettings
+{
+	/** Number of samples the first bake attempt uses, doubled until the error is within MaxError */
+	int32 MinSamples = 32;
+	int32 MaxSamples = 1024;
+	/** Largest error allowed against the source curve, as a fraction of the curve's value range (or of 1 if it is flat) */
+	float MaxError = 0.001f;
+	/** Store the samples as float16 if that is still within MaxError */
+	bool bAllowHalfPrecision = true;
+	/** Linearly interpolate between samples, instead of using the nearest sample */
+	bool bInterpolate = true;
+};
+
+/**
+ * A rich curve sampled at uniform intervals over its key range, so evaluating it is an index calculation and a lerp
+ * instead of a key search and Hermite interpolation. Only curves with constant extrapolation are baked, as the samples
+ * are clamped at either end. Immutable once baked.
+ */
+struct CAMERADYNAMICS_API FCDBakedCurve
+{
+	/**
+	 * Bake a rich curve, checking the result against the source curve between every sample and at every key.
+	 * @return - The baked curve, or null if the curve can't be baked within the settings' error bound.
+	 */
+	static TSharedPtr<const FCDBakedCurve> Bake(const FRichCurve& Curve, const FCDCurveBakeSettings& Settings = FCDCurveBakeSettings());
+
+	FORCEINLINE float Eval(const float Time) const
+	{
+		const float Position = FMath::Clamp((Time - MinTime) * InvSampleInterval, 0.0f, LastSample);
+		if (!bInterpolate) return GetSample(FMath::RoundToInt(Position));
+
+		const int32 Index = FMath::Min(static_cast<int32>(Position), static_cast<int32>(LastSample) - 1);
+		return FMath::Lerp(GetSample(Index), GetSample(Index + 1), Position - Index);
+	}
+
+	int32 GetNumSamples() const { return static_cast<int32>(LastSample) + 1; }
+	bool IsHalfPrecision() const { return !HalfSamples.IsEmpty(); }
+	/** Largest error found against the source curve when baking */
+	float GetMaxError() const { return MaxError; }
+	SIZE_T GetAllocatedSize() const { return Samples.GetAllocatedSize() + HalfSamples.GetAllocatedSize(); }
+
+private:
+
+	FORCEINLINE float GetSample(const int32 Index) const
+	{
+		return HalfSamples.IsEmpty() ? Samples[Index] : HalfSamples[Index].GetFloat();
+	}
+
+	/** Sample the curve and measure the error, returns false if it is above the tolerance */
+	bool SampleCurve(const FRichCurve& Curve, int32 NumSamples, bool bHalf, float Tolerance);
+
+	float MinTime = 0.0f;
+	float InvSampleInterval = 0.0f;
+	/** Index of the last sample, as a float so it can clamp the sample position directly */
+	float LastSample = 0.0f;
+	bool bInterpolate = true;
+	float MaxError = 0.0f;
+
+	/** Only one of these is used */
+	TArray<float> Samples;
+	TArray<FFloat16> HalfSamples;
+};
+
+/**
+ * A rich curve and its baked version, if it has one, evaluated without any lookup. Camera modifiers bake their curves
+ * once per source modifier and share them with their runtime modifiers, see UCDCameraModifierInstanced::GetBakedCurve.
+ */
+struct FCDCurveRef
+{
+	/** The source curve, null if there is no curve */
+	const FRichCurve* Curve = nullptr;
+	/** Null if the curve isn't baked or couldn't be baked */
+	TSharedPtr<const FCDBakedCurve> Baked;
+
+	/** Evaluate the curve, using its baked version if there is one, returning 0 if there is no curve */
+	FORCEINLINE float Eval(const float Time) const
+	{
+		if (Baked.IsValid()) return Baked->Eval(Time);
+		return Curve ? Curve->Eval(Time) : 0.0f;
+	}
+
+	explicit operator bool() const { return Curve != nullptr; }
+};
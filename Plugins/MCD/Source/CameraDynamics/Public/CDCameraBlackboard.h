@@ -0,0 +1,201 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CDCameraBlackboard.generated.h"
+
+/**
+ * Value types for camera parameters.
+ */
+UENUM(BlueprintType)
+enum ECDCameraParameterType
+{
+	CDPARAM_Float		UMETA(DisplayName = "Float"),
+	CDPARAM_Vector		UMETA(DisplayName = "Vector"),
+	CDPARAM_Rotator		UMETA(DisplayName = "Rotator"),
+	CDPARAM_Object		UMETA(DisplayName = "Object")
+};
+
+/**
+ * A named camera parameter declared on a camera data. Gameplay writes to it on the camera manager, and modifiers bound
+ * to it read it, so neither side needs to find the other.
+ */
+USTRUCT(BlueprintType)
+struct CAMERADYNAMICS_API FCDCameraParameterDefinition
+{
+	GENERATED_BODY()
+
+	/** Name used by gameplay and modifier bindings to find this parameter */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics")
+	TEnumAsByte<ECDCameraParameterType> Type = CDPARAM_Float;
+
+	/** Value of the parameter when it is first declared on a camera manager */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics", DisplayName = "Default Value",
+		meta = (EditCondition = "Type == ECDCameraParameterType::CDPARAM_Float", EditConditionHides))
+	float DefaultFloat = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics", DisplayName = "Default Value",
+		meta = (EditCondition = "Type == ECDCameraParameterType::CDPARAM_Vector", EditConditionHides))
+	FVector DefaultVector = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics", DisplayName = "Default Value",
+		meta = (EditCondition = "Type == ECDCameraParameterType::CDPARAM_Rotator", EditConditionHides))
+	FRotator DefaultRotator = FRotator::ZeroRotator;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics", DisplayName = "Default Value",
+		meta = (EditCondition = "Type == ECDCameraParameterType::CDPARAM_Object", EditConditionHides))
+	TObjectPtr<UObject> DefaultObject;
+};
+
+/**
+ * Handle to a camera parameter slot on a camera manager, returned by ACDPlayerCameraManager::FindCameraParameter.
+ * Slots are never freed, so a handle stays valid for the lifetime of the camera manager it was found on.
+ */
+USTRUCT(BlueprintType)
+struct CAMERADYNAMICS_API FCDCameraParameterHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY() int32 Slot = INDEX_NONE;
+
+	UPROPERTY() TEnumAsByte<ECDCameraParameterType> Type = CDPARAM_Float;
+
+	bool IsValid() const { return Slot != INDEX_NONE; }
+};
+
+/**
+ * A modifier input that can be driven by a camera parameter.
+ * Resolved to a slot on the camera manager's blackboard when the modifier is added to the camera.
+ */
+USTRUCT(BlueprintType)
+struct CAMERADYNAMICS_API FCDCameraParameterBinding
+{
+	GENERATED_BODY()
+
+	FCDCameraParameterBinding() = default;
+	explicit FCDCameraParameterBinding(const ECDCameraParameterType InType) : Type(InType) {}
+
+	/** Camera parameter to read this value from. None leaves the value to be set directly. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics")
+	FName Parameter;
+
+	/** Type of the value, set by the modifier that owns the binding */
+	ECDCameraParameterType Type = CDPARAM_Float;
+
+	bool IsBound() const { return Slot != INDEX_NONE; }
+
+private:
+
+	friend struct FCDCameraBlackboard;
+	friend class ACDPlayerCameraManager;
+
+	/** Slot on the camera manager's blackboard, or INDEX_NONE */
+	mutable int32 Slot = INDEX_NONE;
+};
+
+/**
+ * Typed camera parameter storage owned by ACDPlayerCameraManager.
+ * Parameters are declared by camera data when it is added and resolved to slot indices once, after which reads and
+ * writes are plain array accesses. Each write sets a dirty bit, cleared after the camera manager has passed the new
+ * values to the bound modifiers, so modifiers only re-read (and recompute from) parameters that have changed.
+ */
+USTRUCT()
+struct CAMERADYNAMICS_API FCDCameraBlackboard
+{
+	GENERATED_BODY()
+
+	/**
+	 * Add a parameter if it isn't declared yet, with its default value. Declaring an existing parameter keeps its value.
+	 * @return - The parameter's slot, or INDEX_NONE if it is already declared with a different type.
+	 */
+	int32 Declare(const FCDCameraParameterDefinition& Definition);
+
+	/** Find the slot of a declared parameter. Returns INDEX_NONE if it isn't declared with this type. */
+	int32 FindSlot(FName Name, ECDCameraParameterType Type) const;
+
+	/** Does this slot exist and hold this type */
+	bool IsValidSlot(const int32 Slot, const ECDCameraParameterType Type) const
+	{
+		return Slots.IsValidIndex(Slot) && Slots[Slot].Type == Type;
+	}
+
+	float GetFloat(const int32 Slot) const { return Floats[GetValueIndex(Slot, CDPARAM_Float)]; }
+	const FVector& GetVector(const int32 Slot) const { return Vectors[GetValueIndex(Slot, CDPARAM_Vector)]; }
+	const FRotator& GetRotator(const int32 Slot) const { return Rotators[GetValueIndex(Slot, CDPARAM_Rotator)]; }
+	UObject* GetObject(const int32 Slot) const { return Objects[GetValueIndex(Slot, CDPARAM_Object)]; }
+
+	void SetFloat(int32 Slot, float Value);
+	void SetVector(int32 Slot, const FVector& Value);
+	void SetRotator(int32 Slot, const FRotator& Value);
+	void SetObject(int32 Slot, UObject* Value);
+
+	/** Has this slot been written since the bound modifiers last read it */
+	bool IsDirty(const int32 Slot) const { return Dirty[Slot]; }
+
+	/** Has any of these slots been written since the bound modifiers last read it */
+	bool IsAnyDirty(TConstArrayView<int32> InSlots) const;
+
+	bool IsAnyDirty() const { return bAnyDirty; }
+
+	/** Make the modifiers bound to this slot read it, without changing its value */
+	void MarkDirty(const int32 Slot)
+	{
+		Dirty[Slot] = true;
+		bAnyDirty = true;
+	}
+
+	void ClearDirty();
+
+	/**
+	 * Read a bound parameter if it has been written since the bound modifiers last read it.
+	 * @return - True if OutValue was written.
+	 */
+	bool Read(const FCDCameraParameterBinding& Binding, float& OutValue) const;
+	bool Read(const FCDCameraParameterBinding& Binding, FVector& OutValue) const;
+	bool Read(const FCDCameraParameterBinding& Binding, FRotator& OutValue) const;
+
+	/** Read a bound object parameter, which is null if the object isn't of type T */
+	template<typename T>
+	bool Read(const FCDCameraParameterBinding& Binding, T*& OutValue) const
+	{
+		if (!ShouldRead(Binding, CDPARAM_Object)) return false;
+		OutValue = Cast<T>(GetObject(Binding.Slot));
+		return true;
+	}
+
+	int32 Num() const { return Slots.Num(); }
+
+private:
+
+	struct FSlot
+	{
+		FName Name;
+		ECDCameraParameterType Type;
+		/** Index into the value array for the type */
+		int32 ValueIndex;
+	};
+	TArray<FSlot> Slots;
+
+	/** Only used to resolve names, never per frame */
+	TMap<FName, int32> SlotsByName;
+
+	TArray<float> Floats;
+	TArray<FVector> Vectors;
+	TArray<FRotator> Rotators;
+	UPROPERTY() TArray<TObjectPtr<UObject>> Objects;
+
+	TBitArray<> Dirty;
+	bool bAnyDirty = false;
+
+	int32 GetValueIndex(const int32 Slot, const ECDCameraParameterType Type) const
+	{
+		checkSlow(IsValidSlot(Slot, Type));
+		return Slots[Slot].ValueIndex;
+	}
+
+	bool ShouldRead(const FCDCameraParameterBinding& Binding, ECDCameraParameterType Type) const;
+};
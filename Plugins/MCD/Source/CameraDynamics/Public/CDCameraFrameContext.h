@@ -0,0 +1,95 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CoreGlobals.h"
+#include "Engine/EngineTypes.h"
+
+class ACharacter;
+class APawn;
+class APlayerController;
+class USkeletalMeshComponent;
+class USkinnedAsset;
+
+/**
+ * Sockets resolved to bones of a mesh, so socket locations can be read from the mesh's finished pose.
+ * Owned by a camera manager, so it isn't shared between local players. Game thread only.
+ */
+struct CAMERADYNAMICS_API FCDSocketCache
+{
+	/** Get the location of a socket or bone from the mesh's component space pose, resolving it if it isn't cached */
+	FVector GetSocketLocation(const USkeletalMeshComponent& Mesh, FName SocketName);
+
+private:
+
+	struct FEntry
+	{
+		FName SocketName = NAME_None;
+		int32 BoneIndex = INDEX_NONE;
+		/** Transform of the socket relative to its bone */
+		FTransform SocketLocalTransform = FTransform::Identity;
+	};
+
+	/** Entries are rebuilt when the mesh component or its skeletal mesh changes */
+	TWeakObjectPtr<const USkeletalMeshComponent> Mesh;
+	TWeakObjectPtr<const USkinnedAsset> MeshAsset;
+	TArray<FEntry, TInlineAllocator<2>> Entries;
+};
+
+/**
+ * Snapshot of everything a camera manager reads from the world for one camera update.
+ * Captured on the game thread once per frame and shared by every modifier, so they don't each query the controller and
+ * pawn. Work that only needs the values, not the object pointers, can run on worker threads.
+ */
+struct CAMERADYNAMICS_API FCDCameraFrameContext
+{
+	/** Frame the snapshot was captured on, GFrameCounter */
+	uint64 FrameNumber = 0;
+	float DeltaTime = 0.0f;
+
+	/** Objects the snapshot was captured from. Only dereference these on the game thread. */
+	const APlayerController* PlayerController = nullptr;
+	const APawn* Pawn = nullptr;
+	/** The pawn as a character, or null if it isn't one */
+	const ACharacter* Character = nullptr;
+	/** The character's mesh, used for socket source positions */
+	const USkeletalMeshComponent* PawnMesh = nullptr;
+	/** Socket cache of the camera manager the snapshot was captured for, null if it has none */
+	FCDSocketCache* SocketCache = nullptr;
+
+	/** Is there a pawn controlled by the camera manager's player controller */
+	bool bHasPawn = false;
+	FVector PawnLocation = FVector::ZeroVector;
+	FQuat PawnRotation = FQuat::Identity;
+	/** Pawn location raised by its base eye height, the eye height source position */
+	FVector PawnEyeLocation = FVector::ZeroVector;
+	FVector PawnVelocity = FVector::ZeroVector;
+
+	/** Does the pawn have a character movement component, the movement values are only set if it does */
+	bool bHasCharacterMovement = false;
+	bool bIsMovingOnGround = false;
+	TEnumAsByte<EMovementMode> MovementMode = MOVE_None;
+
+	/** The player controller's rotation input for this frame */
+	FRotator RotationInput = FRotator::ZeroRotator;
+
+	/** Capture the world state for a player controller. Game thread only. */
+	static FCDCameraFrameContext Capture(const APlayerController* InPlayerController, float InDeltaTime,
+	                                     FCDSocketCache* InSocketCache = nullptr);
+
+	/** Location of a socket or bone on the pawn's mesh, or zero without a mesh. Game thread only. */
+	FVector GetPawnSocketLocation(FName SocketName) const;
+
+	/** Was this captured during the current frame */
+	bool IsCurrent() const { return FrameNumber == GFrameCounter; }
+
+	/** Pawn velocity for modifiers that need it, or null without a pawn */
+	const FVector* GetPawnVelocity() const { return bHasPawn ? &PawnVelocity : nullptr; }
+
+	/** Rotate a vector from the pawn's local space into world space */
+	FVector RotateFromPawn(const FVector& Vector) const { return PawnRotation.RotateVector(Vector); }
+
+	/** Rotate a vector from world space into the pawn's local space */
+	FVector UnrotateToPawn(const FVector& Vector) const { return PawnRotation.UnrotateVector(Vector); }
+};
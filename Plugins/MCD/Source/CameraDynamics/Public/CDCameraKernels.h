@@ -0,0 +1,146 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CDBakedCurve.h"
+#include "Curves/RichCurve.h"
+#include "Data/CameraDynamicDataTypes.h"
+#include "Modifiers/CDCameraModifier_Instanced.h"
+
+/**
+ * Stateless math shared by the native camera modifiers and the camera manager's batched evaluation path.
+ * Keeping these in one place means both paths always produce the same camera.
+ */
+namespace CDCameraKernels
+{
+	/**
+	 * Evaluate a curve, using its baked version if there is one, returning 0 if there is no curve.
+	 * Matches UCameraDynamicsFunctionLibrary::EvaluateRuntimeFloatCurve
+	 */
+	FORCEINLINE float EvalCurve(const FCDCurveRef& Curve, const float Time)
+	{
+		return Curve.Eval(Time);
+	}
+
+	/** Step an alpha towards its target. Matches UCDCameraModifierInstanced::UpdateAlpha */
+	FORCEINLINE float StepAlpha(const float Alpha, const float TargetAlpha, const float BlendTime, const float DeltaTime)
+	{
+		// no blend time means no blending, just go directly to target alpha
+		if (BlendTime <= 0.0f) return TargetAlpha;
+		// interpolate towards the target, while protecting against overshooting
+		if (Alpha > TargetAlpha) return FMath::Max<float>(Alpha - DeltaTime / BlendTime, TargetAlpha);
+		return FMath::Min<float>(Alpha + DeltaTime / BlendTime, TargetAlpha);
+	}
+
+	/** Pick the blend time for a target alpha, preferring a custom blend time if one is set (>= 0) */
+	FORCEINLINE float GetBlendTime(const float TargetAlpha, const float AlphaInTime, const float AlphaOutTime, const float CustomBlendTime)
+	{
+		if (CustomBlendTime >= 0.0f) return CustomBlendTime;
+		return (TargetAlpha == 0.0f) ? AlphaOutTime : AlphaInTime;
+	}
+
+	/**
+	 * Resolve the alpha used for blending, from the appropriate custom blend curve if there is one.
+	 * The curves are sampled at the blend times, like UCDCameraModifierInstanced::GetCustomBlendAlpha always has.
+	 * Curves should be empty if the custom blend is unused.
+	 */
+	FORCEINLINE float ResolveCustomBlendAlpha(const float Alpha, const bool bBlendIn, const float AlphaInTime, const float AlphaOutTime,
+	                                          const FCDCurveRef& CustomBlendIn, const FCDCurveRef& CustomBlendOut)
+	{
+		// Early return alpha if it is fully blended
+		if (Alpha == 0.0f || Alpha == 1.0f) return Alpha;
+		if (bBlendIn && CustomBlendIn) return EvalCurve(CustomBlendIn, AlphaInTime);
+		if (CustomBlendOut) return EvalCurve(CustomBlendOut, AlphaOutTime);
+		return Alpha;
+	}
+
+	/** Move a value towards its target, or snap to it if smoothing is disabled */
+	FORCEINLINE float StepSmoothedValue(const float Current, const float Target, const bool bSmooth, const float Speed, const float DeltaTime)
+	{
+		return bSmooth ? FMath::FInterpTo(Current, Target, DeltaTime, Speed) : Target;
+	}
+
+	/** Apply an FOV change based on the modification type */
+	FORCEINLINE float ApplyFOVChange(const float FOV, const float FOVChange, const ECameraModOpType ModificationType)
+	{
+		switch (ModificationType)
+		{
+		case CMO_Absolute:			return FOVChange;
+		case CMO_Additive:			return FOV + FOVChange;
+		case CMO_Multiplicative:	return FOV * FOVChange;
+		default:					return FOV;
+		}
+	}
+
+	/** Offset a location along the forward vector of a rotation */
+	FORCEINLINE FVector ApplyForwardDistance(const FVector& Location, const FQuat& Rotation, const float Distance)
+	{
+		return Location + Rotation.GetForwardVector() * Distance;
+	}
+
+	/**
+	 * Get the pitch of a view rotation in the [0, 360) range used by the controller's view rotation, so looking down
+	 * gives a pitch above 270 the same as reading FMinimalViewInfo::Rotation did.
+	 */
+	FORCEINLINE float GetViewPitch(const FQuat& Rotation)
+	{
+		const float ForwardZ = FMath::Clamp(static_cast<float>(Rotation.GetForwardVector().Z), -1.0f, 1.0f);
+		return static_cast<float>(FRotator::ClampAxis(FMath::RadiansToDegrees(FMath::Asin(ForwardZ))));
+	}
+
+	/** Tuning values for UCDCameraModifier_Position_Lag, flattened so they can be stored contiguously */
+	struct FLagParams
+	{
+		float InterpSpeedMod = 1.0f;
+		FCDCameraAxisData AxisInfluence;
+		bool bUseMaxDistance = false;
+		float MaxDistanceBeforeSnap = 0.0f;
+		bool bZeroValueSnaps = true;
+		/** Empty if the interp speed curve is unused */
+		FCDCurveRef InterpSpeedCurve;
+		bool bAddDeltaRotationToInterpSpeed = false;
+		float DeltaRotationToInterpSpeedScale = 0.0f;
+		/** Empty if velocity does not influence the rotation interp speed */
+		FCDCurveRef DeltaYawVelocityInfluenceCurve;
+		FCDCameraAxisData DeltaYawVelocityAxisInfluence;
+	};
+
+	/**
+	 * Step the position lag towards the incoming view location. Matches UCDCameraModifier_Position_Lag.
+	 * @param PawnVelocity - Velocity of the controlled pawn, or null if there is no pawn.
+	 * @return - The lagged camera position.
+	 */
+	CAMERADYNAMICS_API FVector StepPositionLag(const FLagParams& Params, const FVector& ViewLocation, const FQuat& ViewRotation,
+	                                           const FVector* PawnVelocity, float DeltaTime, FVector& InOutLaggedPosition,
+	                                           FQuat& InOutLastFrameRotation, float& OutInterpSpeed, float& InOutDistanceToTarget);
+
+	/**
+	 * Apply a pitch driven FOV change. Matches UCDCameraModifier_FOV_PitchMod.
+	 * @param Curve - The pitch to FOV curve.
+	 * @return - The modified FOV.
+	 */
+	CAMERADYNAMICS_API float ApplyPitchToFOV(float FOV, float Pitch, const FCDCurveRef& Curve, ECameraCurveModType EvaluationType,
+	                                         bool bRemapPitch, const FFloatRange& PitchRange, const FFloatRange& PitchOutRange);
+
+	/** Tuning values for UCDCameraModifier_Position_DynamicZ */
+	struct FDynamicZParams
+	{
+		/** Empty if there is no airborne interp speed curve */
+		FCDCurveRef AirborneInterpSpeed;
+		/** Empty if there is no return speed curve */
+		FCDCurveRef ReturnSpeed;
+		float SnapThreshold = 10.0f;
+	};
+
+	/**
+	 * Step the Z position of the camera while the character is airborne or returning to the ground.
+	 * Matches UCDCameraModifier_Position_DynamicZ.
+	 * @param bGrounded - Is the character moving on the ground.
+	 * @param InOutViewLocation - The view location, modified in place.
+	 * @param bInOutShouldDirectInterpZ - Set when the character lands, cleared once the camera has caught up.
+	 */
+	CAMERADYNAMICS_API void StepDynamicZ(const FDynamicZParams& Params, bool bGrounded, float DeltaTime, FVector& InOutViewLocation,
+	                                     FVector& InOutLastGroundedPosition, FVector& InOutCurrentPosition,
+	                                     bool& bInOutShouldDirectInterpZ);
+}
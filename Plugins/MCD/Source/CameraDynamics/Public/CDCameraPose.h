@@ -0,0 +1,102 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/CameraTypes.h"
+
+/**
+ * Camera location, rotation and FOV, passed by reference through the camera manager's modifier list.
+ * Rotation is kept as a quaternion so modifiers and blends don't convert to and from FRotator, conversion only happens
+ * when reading from or writing to an FMinimalViewInfo.
+ */
+struct FCDCameraPose
+{
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	float FOV = 90.0f;
+
+	FCDCameraPose() = default;
+
+	FCDCameraPose(const FVector& InLocation, const FQuat& InRotation, const float InFOV)
+		: Location(InLocation), Rotation(InRotation), FOV(InFOV)
+	{
+	}
+
+	explicit FCDCameraPose(const FMinimalViewInfo& View)
+		: Location(View.Location), Rotation(View.Rotation.Quaternion()), FOV(View.FOV)
+	{
+	}
+
+	/**
+	 * Write this pose to a view. The rotation is only converted back if it changed, so a view that no modifier rotated
+	 * keeps its exact FRotator.
+	 * @param SourceRotation - The rotation of this pose when it was read from the view.
+	 */
+	void ApplyTo(FMinimalViewInfo& View, const FQuat& SourceRotation) const
+	{
+		View.Location = Location;
+		View.FOV = FOV;
+		if (!(Rotation == SourceRotation)) View.Rotation = Rotation.Rotator();
+	}
+
+	/** Blend between two poses, only slerping the rotation if it differs */
+	static FCDCameraPose Blend(const FCDCameraPose& From, const FCDCameraPose& To, const float Alpha)
+	{
+		return FCDCameraPose(FMath::Lerp(From.Location, To.Location, Alpha),
+		                     From.Rotation == To.Rotation ? To.Rotation : FQuat::Slerp(From.Rotation, To.Rotation, Alpha),
+		                     FMath::Lerp(From.FOV, To.FOV, Alpha));
+	}
+
+	/** Interpolate between two rotations along the shortest path. Alpha may be above 1 to extrapolate past To. */
+	static FQuat InterpolateRotation(const FQuat& From, const FQuat& To, const float Alpha)
+	{
+		if (From == To) return To;
+
+		FQuat Delta = To * From.Inverse();
+		if (Delta.W < 0.0f) Delta = -Delta;
+
+		FVector Axis;
+		float Angle;
+		Delta.ToAxisAndAngle(Axis, Angle);
+		return FQuat(Axis, Angle * Alpha) * From;
+	}
+};
+
+/**
+ * A modifier's change to a camera pose. Used to keep applying a reduced rate modifier's last result on the frames
+ * it isn't evaluated.
+ */
+struct FCDPoseDelta
+{
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	float FOV = 0.0f;
+
+	/** Get the change from one pose to another */
+	static FCDPoseDelta Between(const FCDCameraPose& From, const FCDCameraPose& To)
+	{
+		FCDPoseDelta Delta;
+		Delta.Location = To.Location - From.Location;
+		Delta.Rotation = From.Rotation == To.Rotation ? FQuat::Identity : To.Rotation * From.Rotation.Inverse();
+		Delta.FOV = To.FOV - From.FOV;
+		return Delta;
+	}
+
+	/** Interpolate between two deltas. Alpha may be above 1 to extrapolate past To. */
+	static FCDPoseDelta Interpolate(const FCDPoseDelta& From, const FCDPoseDelta& To, const float Alpha)
+	{
+		FCDPoseDelta Delta;
+		Delta.Location = From.Location + (To.Location - From.Location) * Alpha;
+		Delta.Rotation = FCDCameraPose::InterpolateRotation(From.Rotation, To.Rotation, Alpha);
+		Delta.FOV = From.FOV + (To.FOV - From.FOV) * Alpha;
+		return Delta;
+	}
+
+	void ApplyTo(FCDCameraPose& InOutPose) const
+	{
+		InOutPose.Location += Location;
+		if (!(Rotation == FQuat::Identity)) InOutPose.Rotation = Rotation * InOutPose.Rotation;
+		InOutPose.FOV += FOV;
+	}
+};
@@ -0,0 +1,220 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CDCameraFrameContext.h"
+#include "CDCameraKernels.h"
+#include "CDCameraPose.h"
+#include "Data/CameraDynamicDataTypes.h"
+#include "Modifiers/CDCameraModifier_Rotation_Override.h"
+#include "Modifiers/CDCameraModifier_Sweep_Basic.h"
+
+class UCDCameraData;
+class UCDCameraModifierInstanced;
+class UWorld;
+
+/** Built-in modifiers that can be compiled into a camera program */
+enum class ECDCameraOpCode : uint8
+{
+	PositionBase,
+	PositionOffset,
+	PositionDistance,
+	PositionLag,
+	PositionDynamicZ,
+	FOVAdjust,
+	FOVPitchMod,
+	RotationOverride,
+	SweepBasic,
+
+	Num
+};
+
+/** A single instruction in a camera program */
+struct FCDCameraOp
+{
+	ECDCameraOpCode OpCode;
+	/** Index into the parameter block for this op code */
+	uint16 ParamIndex;
+	/** Index of the modifier in UCDCameraData::CameraModifiers that this op was compiled from */
+	uint16 SourceIndex;
+};
+
+/** Blend settings for a compiled modifier. Curves are owned by the source modifier and are empty if unused. */
+struct FCDCameraOpBlend
+{
+	float AlphaInTime = 0.0f;
+	float AlphaOutTime = 0.0f;
+	FCDCurveRef CustomBlendIn;
+	FCDCurveRef CustomBlendOut;
+};
+
+/*
+ * Parameter blocks, one per compiled modifier
+ */
+
+struct FCDPositionBaseParams
+{
+	FCameraSourcePositionData CameraBasePosition;
+	FCDCameraAxisData AxisInfluence;
+};
+
+struct FCDPositionDistanceParams
+{
+	float TargetDistance = 0.0f;
+	bool bSmoothDistanceChanges = false;
+	float ChangeSmoothing = 0.0f;
+};
+
+struct FCDFOVAdjustParams
+{
+	float DefaultFOVChange = 0.0f;
+	bool bUseSmoothing = false;
+	float SmoothingSpeed = 0.0f;
+	ECameraModOpType ModificationType = CMO_Additive;
+};
+
+struct FCDFOVPitchModParams
+{
+	/** Owned by the source modifier */
+	FCDCurveRef PitchToFOVCurve;
+	ECameraCurveModType CurveEvaluationType = ECM_Additive;
+	bool bRemapPitch = false;
+	FFloatRange PitchRange;
+	FFloatRange PitchOutRange;
+};
+
+struct FCDRotationOverrideParams
+{
+	ECDRotationOverrideType RotationOverrideType = CAMROT_None;
+	FRotator RotationOverride = FRotator::ZeroRotator;
+	FVector LookAtLocation = FVector::ZeroVector;
+};
+
+/** A contiguous range of compiled modifiers, run by a single program modifier on the camera manager */
+struct FCDCameraProgramRun
+{
+	int32 FirstOp = 0;
+	int32 NumOps = 0;
+	/** First parameter block used by this run for each op code, parameter blocks of a run are contiguous */
+	int32 FirstParam[static_cast<int32>(ECDCameraOpCode::Num)] = {};
+	int32 NumParams[static_cast<int32>(ECDCameraOpCode::Num)] = {};
+};
+
+/** Runtime state of a camera program run. Owned by the program modifier, so the program itself stays immutable. */
+struct FCDCameraProgramState
+{
+	/** Alpha of each op in the run */
+	TArray<float> Alpha;
+
+	TArray<float> Distance;
+	TArray<float> FOVChange;
+
+	struct FLagState
+	{
+		FVector CameraPositionTarget = FVector::ZeroVector;
+		FVector LaggedCameraPosition = FVector::ZeroVector;
+		FQuat LastFrameRotation = FQuat::Identity;
+		float InterpSpeed = 0.0f;
+		float DistanceToTarget = 0.0f;
+	};
+	TArray<FLagState> Lag;
+
+	struct FDynamicZState
+	{
+		FVector LastGroundedPosition = FVector::ZeroVector;
+		FVector CurrentPosition = FVector::ZeroVector;
+		bool bShouldDirectInterpZ = false;
+		bool bWasGrounded = true;
+	};
+	TArray<FDynamicZState> DynamicZ;
+};
+
+/** Everything a camera program needs from the camera manager for one evaluation */
+struct FCDCameraProgramContext
+{
+	UWorld* World = nullptr;
+	/** World state shared by the camera manager's modifiers, never null */
+	const FCDCameraFrameContext* Frame = nullptr;
+	/** Camera location from the last frame, used by look at rotation overrides */
+	FVector CameraLocation = FVector::ZeroVector;
+	float DeltaTime = 0.0f;
+	/** Are the ops blending in, false once the program modifier is pending disable */
+	bool bBlendIn = true;
+};
+
+/**
+ * A camera data stack flattened into a linear array of op codes and parameter blocks, evaluated by a small interpreter
+ * without going through the modifier objects. Only exact built-in modifier classes without Blueprint logic are compiled,
+ * anything else splits the program into runs and is added to the camera manager as a normal modifier.
+ *
+ * Parameters are copied from the source modifiers when the program is compiled, so gameplay changes to compiled
+ * modifiers aren't possible. Curves are referenced from the source modifiers.
+ */
+struct CAMERADYNAMICS_API FCDCameraProgram
+{
+	TArray<FCDCameraOp> Ops;
+	/** Blend settings, parallel to Ops */
+	TArray<FCDCameraOpBlend> Blends;
+	TArray<FCDCameraProgramRun> Runs;
+
+	TArray<FCDPositionBaseParams> PositionBaseParams;
+	TArray<FCameraOffsetPositionData> PositionOffsetParams;
+	TArray<FCDPositionDistanceParams> PositionDistanceParams;
+	TArray<CDCameraKernels::FLagParams> PositionLagParams;
+	TArray<CDCameraKernels::FDynamicZParams> PositionDynamicZParams;
+	TArray<FCDFOVAdjustParams> FOVAdjustParams;
+	TArray<FCDFOVPitchModParams> FOVPitchModParams;
+	TArray<FCDRotationOverrideParams> RotationOverrideParams;
+	TArray<FCameraTraceData> SweepBasicParams;
+
+	/** Index of the run starting at each source modifier, or INDEX_NONE. Parallel to UCDCameraData::CameraModifiers. */
+	TArray<int32> RunStartingAtSource;
+	/** Whether each source modifier was compiled. Parallel to UCDCameraData::CameraModifiers. */
+	TBitArray<> CompiledSources;
+
+	/** Compile a camera data's modifiers */
+	static TSharedRef<const FCDCameraProgram> Compile(const UCDCameraData& CameraData);
+
+	/** Can this modifier be compiled into a program */
+	static bool CanCompile(const UCDCameraModifierInstanced* Modifier);
+
+	bool IsSourceCompiled(const int32 SourceIndex) const
+	{
+		return CompiledSources.IsValidIndex(SourceIndex) && CompiledSources[SourceIndex];
+	}
+
+	/** Set up the runtime state for a run */
+	void InitializeState(int32 RunIndex, FCDCameraProgramState& OutState, const FVector& CameraLocation, const FQuat& CameraRotation) const;
+
+	/** Step the alpha of every op in a run. Matches UCDCameraModifierInstanced::UpdateAlpha. */
+	void UpdateAlpha(int32 RunIndex, FCDCameraProgramState& State, float TargetAlpha, float CustomBlendTime, float DeltaTime) const;
+
+	/** Run the camera modification of every op in a run, blending each op by its own alpha */
+	void Execute(int32 RunIndex, FCDCameraProgramState& State, const FCDCameraProgramContext& Context, FCDCameraPose& InOutPose) const;
+
+	/**
+	 * Run the view rotation processing of every op in a run, blending each op by its own alpha.
+	 * @return - True if an op should be the last to process view rotation.
+	 */
+	bool ExecuteViewRotation(int32 RunIndex, const FCDCameraProgramState& State, const FCDCameraProgramContext& Context,
+	                         FRotator& InOutViewRotation, FRotator& InOutDeltaRot) const;
+
+	/** Get the alpha used for blending an op, after custom blend curves */
+	float GetBlendAlpha(int32 OpIndex, const FCDCameraProgramState& State, int32 RunIndex, bool bBlendIn) const;
+
+	/** Get a display name for an op code */
+	static const TCHAR* GetOpCodeName(ECDCameraOpCode OpCode);
+
+private:
+
+	/** Index of an op's parameter block inside the run's state arrays */
+	int32 GetStateIndex(const FCDCameraProgramRun& Run, const FCDCameraOp& Op) const
+	{
+		return Op.ParamIndex - Run.FirstParam[static_cast<int32>(Op.OpCode)];
+	}
+
+	void ExecuteOp(const FCDCameraProgramRun& Run, const FCDCameraOp& Op, FCDCameraProgramState& State,
+	               const FCDCameraProgramContext& Context, FVector& InOutLocation, float& InOutFOV,
+	               const FQuat& ViewRotation) const;
+};
@@ -0,0 +1,106 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "WorldCollision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CDCameraQuerySubsystem.generated.h"
+
+/** A sphere sweep requested by a camera modifier */
+struct FCDCameraQuery
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	float Radius = 0.0f;
+	TEnumAsByte<ECollisionChannel> Channel = ECC_Camera;
+	/** Actor ignored by the sweep, usually the pawn being viewed */
+	const AActor* IgnoredActor = nullptr;
+
+	bool operator==(const FCDCameraQuery& Other) const
+	{
+		return Start == Other.Start && End == Other.End && Radius == Other.Radius && Channel == Other.Channel
+			&& IgnoredActor == Other.IgnoredActor;
+	}
+
+	friend uint32 GetTypeHash(const FCDCameraQuery& Query)
+	{
+		uint32 Hash = HashCombineFast(GetTypeHash(Query.Start), GetTypeHash(Query.End));
+		Hash = HashCombineFast(Hash, GetTypeHash(Query.Radius));
+		Hash = HashCombineFast(Hash, GetTypeHash(Query.Channel.GetValue()));
+		return HashCombineFast(Hash, GetTypeHash(Query.IgnoredActor));
+	}
+};
+
+/** Result of a camera sweep, as a fraction along the swept segment */
+struct FCDCameraQueryResult
+{
+	bool bHit = false;
+	float Fraction = 1.0f;
+
+	/** Location along a segment, which doesn't have to be the one that was swept */
+	FVector GetLocation(const FVector& Start, const FVector& End) const
+	{
+		return bHit ? FMath::Lerp(Start, End, Fraction) : End;
+	}
+};
+
+/**
+ * Runs the collision sweeps of every camera in the world. Identical sweeps requested during the same frame, by any
+ * player, are only run once, and the collision query params for each ignored actor are built once and reused.
+ *
+ * Synchronous sweeps are needed during the camera update, so they run when requested and their results are shared for
+ * the rest of the frame. Async sweeps are issued to the world's async trace buffer, which runs every sweep of the frame
+ * as one batch, and identical requests share a trace handle.
+ */
+UCLASS()
+class CAMERADYNAMICS_API UCDCameraQuerySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Sweep now, or reuse the result of an identical sweep from this frame */
+	FCDCameraQueryResult Sweep(const FCDCameraQuery& Query);
+
+	/** Issue an async sweep, to be read next frame with GetAsyncSweepResult. Identical requests this frame share a handle. */
+	FTraceHandle RequestAsyncSweep(const FCDCameraQuery& Query);
+
+	/** Read an async sweep. Returns false if it isn't ready yet, or the handle has expired. */
+	bool GetAsyncSweepResult(const FTraceHandle& Handle, FCDCameraQueryResult& OutResult) const;
+
+	/** Get the collision query params for sweeps ignoring an actor. Built once per actor and reused. */
+	const FCollisionQueryParams& GetQueryParams(const AActor* IgnoredActor);
+
+	/**
+	 * Get the query counters since they were last reset.
+	 * @param Requested - Number of sweeps requested by cameras.
+	 * @param Executed - Number of sweeps actually run or issued.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Performance")
+	void GetQueryStats(int32& Requested, int32& Executed) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Performance")
+	void ResetQueryStats();
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+
+	/** Clear the results of the previous frame, if this is the first request of a new frame */
+	void BeginFrameIfNeeded();
+
+	/** Frame the results are from, GFrameCounter */
+	uint64 CurrentFrame = 0;
+
+	TMap<FCDCameraQuery, FCDCameraQueryResult> SweepResults;
+	TMap<FCDCameraQuery, FTraceHandle> AsyncSweeps;
+	TMap<TObjectKey<AActor>, FCollisionQueryParams> QueryParams;
+
+	int32 QueriesRequested = 0;
+	int32 QueriesExecuted = 0;
+};
@@ -3,10 +3,35 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CDCameraBlackboard.h"
 #include "Engine/DataAsset.h"
 #include "CDCameraStack.generated.h"
 
 class UCDCameraModifierInstanced;
+struct FCDCameraProgram;
+
+/**
+ * Handle to a camera data added to a camera manager, returned by ACDPlayerCameraManager::AddCameraData.
+ * Each add gets its own handle, so the same camera data can be active on several camera managers (or several times
+ * on one camera manager) without the runtime modifiers being confused with each other.
+ */
+USTRUCT(BlueprintType)
+struct CAMERADYNAMICS_API FCDCameraDataHandle
+{
+	GENERATED_BODY()
+
+	/** Index into the camera manager's camera data instance table */
+	UPROPERTY() int32 Index = INDEX_NONE;
+
+	/** Incremented each time an instance table entry is reused, so old handles stop matching */
+	UPROPERTY() int32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+
+	bool operator==(const FCDCameraDataHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FCDCameraDataHandle& Other) const { return !(*this == Other); }
+};
 
 /**
  * Data asset that contains a stack of camera modifiers that can be applied to a camera manager. 
@@ -32,4 +57,38 @@ public:
 	 */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Instanced, Category = "Camera Dynamics", meta = (ShowInnerProperties))
 	TArray<TObjectPtr<UCDCameraModifierInstanced>> CameraModifiers;
+
+	/**
+	 * Camera parameters this camera data declares on the camera manager when it is added.
+	 * Gameplay writes to them with ACDPlayerCameraManager::SetCameraParameter functions, and modifier inputs can be
+	 * bound to them by name. Parameters stay declared after the camera data is removed, keeping their last value.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Camera Dynamics")
+	TArray<FCDCameraParameterDefinition> Parameters;
+
+	/**
+	 * If true, the built-in modifiers in this camera data are compiled into a flat program when it is loaded.
+	 * The program is evaluated without creating a runtime modifier for each compiled modifier, which is cheaper per frame
+	 * and per instance. Blueprint and custom modifiers are still added as normal modifiers.
+	 *
+	 * Compiled modifiers can't be found on the camera manager or changed at runtime, so only enable this for camera data
+	 * that gameplay code doesn't modify.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Camera Dynamics|Performance")
+	bool bCompileCameraProgram;
+
+	/** Get the compiled program for this camera data, compiling it if needed. Null if bCompileCameraProgram is false. */
+	TSharedPtr<const FCDCameraProgram> GetCameraProgram();
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	/** Shared with the program modifiers running it, so recompiling doesn't affect modifiers that are already active */
+	TSharedPtr<const FCDCameraProgram> CameraProgram;
 };
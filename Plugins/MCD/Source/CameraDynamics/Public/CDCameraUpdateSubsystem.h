@@ -0,0 +1,41 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CDCameraUpdateSubsystem.generated.h"
+
+class ACDPlayerCameraManager;
+
+/**
+ * Runs the view independent part of every local player's camera update in parallel, before the camera managers update.
+ * Each camera manager with bParallelPreUpdate captures a frame context and its modifiers' values on the game thread,
+ * then steps its batched modifiers on a worker thread. The game thread waits for every camera before continuing.
+ * Only the batched native modifiers (Offset, Distance, FOV_Adjust and Lag) are overlapped. The view dependent part of
+ * each update, and every other modifier, including FOV_PitchMod, Follow_VelocityToYaw, world query and Blueprint
+ * modifiers, still runs serially in the camera update.
+ */
+UCLASS()
+class CAMERADYNAMICS_API UCDCameraUpdateSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/** Capture frame contexts and run the pre-update of every local camera manager that wants one */
+	void PreUpdateCameras(float DeltaTime);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+
+	/** Camera managers being pre-updated this frame, kept to avoid allocating every frame */
+	TArray<ACDPlayerCameraManager*> CameraManagers;
+};
@@ -0,0 +1,189 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CDCameraKernels.h"
+#include "CDCameraPose.h"
+
+class UCameraModifier;
+class UCDCameraModifierInstanced;
+class UCDCameraModifier_Position_Offset;
+class UCDCameraModifier_Position_Distance;
+class UCDCameraModifier_FOV_Adjust;
+class UCDCameraModifier_Position_Lag;
+
+/** Native modifier types that can be evaluated from the camera manager's batch buffers */
+enum class ECDBatchedModifierType : uint8
+{
+	None,
+	Offset,
+	Distance,
+	FOVAdjust,
+	Lag
+};
+
+/** Location of a modifier inside the batch buffers */
+struct FCDBatchHandle
+{
+	ECDBatchedModifierType Type = ECDBatchedModifierType::None;
+	int32 Slot = INDEX_NONE;
+
+	bool IsValid() const { return Type != ECDBatchedModifierType::None; }
+};
+
+/**
+ * Blend state columns shared by every batched modifier type, and by the camera manager's packed alpha pass.
+ * Mirrors UCDCameraModifierInstanced::UpdateAlpha and UCDCameraModifierInstanced::GetCustomBlendAlpha.
+ */
+struct FCDBatchBlendColumns
+{
+	TArray<float> Alpha;
+	TArray<float> TargetAlpha;
+	TArray<float> AlphaInTime;
+	TArray<float> AlphaOutTime;
+	TArray<float> CustomBlendTime;
+	TArray<FCDCurveRef> CustomBlendIn;
+	TArray<FCDCurveRef> CustomBlendOut;
+	TArray<bool> bPendingDisable;
+	TArray<bool> bDisabled;
+	/** Alpha after custom blend curves, used for the final blend of each modifier */
+	TArray<float> BlendedAlpha;
+	/** Alpha before the last Step, so the step can be undone */
+	TArray<float> AlphaBeforeAdvance;
+
+	void Add(UCDCameraModifierInstanced* Modifier);
+	void Refresh(int32 Slot, UCDCameraModifierInstanced* Modifier);
+	void RemoveAtSwap(int32 Slot);
+	void Reset();
+	void Step(float DeltaTime);
+
+	/** Undo the last Step for a single slot */
+	void RewindSlot(int32 Slot);
+};
+
+/**
+ * Structure-of-arrays storage for the hot runtime state of native camera modifiers, owned by ACDPlayerCameraManager.
+ * Only exact native classes are batched, since Blueprint subclasses may implement the blended Blueprint events.
+ *
+ * Each frame the batch pulls the values gameplay is expected to drive (target distance, target FOV change, offsets),
+ * steps alpha and smoothing one modifier type at a time, then evaluates each modifier in stack order without virtual
+ * dispatch. Tuning values are captured when a modifier is registered, use Refresh after changing them at runtime.
+ * State is written back to the modifier objects on Flush, so debug display and the object path stay valid.
+ */
+struct CAMERADYNAMICS_API FCDModifierBatch
+{
+	/** Can this modifier be evaluated by the batch */
+	static bool CanBatch(const UCameraModifier* Modifier);
+
+	/** Register a modifier, capturing its current state. Returns an invalid handle if the modifier can't be batched. */
+	FCDBatchHandle Register(UCameraModifier* Modifier);
+
+	/** Write the modifier's state back to the object and remove it from the batch */
+	void Unregister(UCameraModifier* Modifier);
+
+	/** Unregister every modifier */
+	void Reset();
+
+	/** Re-capture the tuning values and blend state of a registered modifier */
+	void Refresh(UCameraModifier* Modifier);
+
+	/** Re-capture only the blend state of a registered modifier */
+	void RefreshBlendState(UCameraModifier* Modifier);
+
+	FCDBatchHandle FindHandle(const UCameraModifier* Modifier) const;
+
+	bool IsEmpty() const { return Handles.IsEmpty(); }
+
+	/**
+	 * Pull gameplay-driven values from the modifier objects. Game thread only.
+	 * @return - True if a value used by Advance changed.
+	 */
+	bool Gather();
+
+	/** Step blend and smoothing state for every batched modifier, one type at a time */
+	void Advance(float DeltaTime);
+
+	/** Has a modifier been registered or refreshed since the last Advance, so the step used stale values */
+	bool HasChangedSinceAdvance() const { return bChangedSinceAdvance; }
+
+	/** Undo the last Advance, so the batch can be stepped again. Slots registered since then are left as they are. */
+	void Rewind();
+
+	/** Undo the last Advance for a single modifier, for modifiers the camera update didn't reach this frame */
+	void RewindSlot(const FCDBatchHandle& Handle);
+
+	/** Evaluate a single batched modifier on the camera pose */
+	void Evaluate(const FCDBatchHandle& Handle, float DeltaTime, const FVector* PawnVelocity, FCDCameraPose& InOutPose);
+
+	/** Is a batched modifier enabled and fully blended in, after this frame's Advance */
+	bool IsFullyBlendedIn(const FCDBatchHandle& Handle) const;
+
+	/** Resync the state of a batched modifier that follows the incoming pose, after the modifier's result was overwritten */
+	void ResumeFromMasked(const FCDBatchHandle& Handle, const FCDCameraPose& ViewPose);
+
+	/** Write alphas back to the modifiers and disable the ones that have finished blending out */
+	void Finish();
+
+	/** Write all runtime state back to the modifier objects */
+	void Flush();
+
+private:
+
+	struct FOffsetColumns
+	{
+		TArray<UCDCameraModifier_Position_Offset*> Modifiers;
+		FCDBatchBlendColumns Blend;
+		TArray<FCameraOffsetPositionData> OffsetData;
+		TArray<FVector> UnmodifiedPosition;
+		TArray<FVector> ModifiedPosition;
+	} OffsetBatch;
+
+	struct FDistanceColumns
+	{
+		TArray<UCDCameraModifier_Position_Distance*> Modifiers;
+		FCDBatchBlendColumns Blend;
+		TArray<float> Distance;
+		TArray<float> DistanceBeforeAdvance;
+		TArray<float> TargetDistance;
+		TArray<float> ChangeSmoothing;
+		TArray<bool> bSmooth;
+	} DistanceBatch;
+
+	struct FFOVColumns
+	{
+		TArray<UCDCameraModifier_FOV_Adjust*> Modifiers;
+		FCDBatchBlendColumns Blend;
+		TArray<float> FOVChange;
+		TArray<float> FOVChangeBeforeAdvance;
+		TArray<float> TargetFOVChange;
+		TArray<float> ChangedFOV;
+		TArray<float> SmoothingSpeed;
+		TArray<bool> bSmooth;
+		TArray<TEnumAsByte<ECameraModOpType>> ModificationType;
+	} FOVBatch;
+
+	struct FLagColumns
+	{
+		TArray<UCDCameraModifier_Position_Lag*> Modifiers;
+		FCDBatchBlendColumns Blend;
+		TArray<CDCameraKernels::FLagParams> Params;
+		TArray<FVector> CameraPositionTarget;
+		TArray<FVector> LaggedCameraPosition;
+		TArray<FQuat> LastFrameRotation;
+		TArray<float> InterpSpeed;
+		TArray<float> DistanceToTarget;
+	} LagBatch;
+
+	/** Lookup from modifier to its location in the buffers, only used when the stack changes */
+	TMap<const UCameraModifier*, FCDBatchHandle> Handles;
+
+	bool bChangedSinceAdvance = false;
+
+	FCDBatchBlendColumns& GetBlendColumns(ECDBatchedModifierType Type);
+	const FCDBatchBlendColumns& GetBlendColumns(ECDBatchedModifierType Type) const;
+	UCDCameraModifierInstanced* GetModifier(const FCDBatchHandle& Handle) const;
+	void CaptureTuning(const FCDBatchHandle& Handle);
+	void FlushSlot(const FCDBatchHandle& Handle);
+	void RemoveSlot(const FCDBatchHandle& Handle);
+};
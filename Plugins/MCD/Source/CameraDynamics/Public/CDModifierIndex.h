@@ -0,0 +1,61 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class UCameraModifier;
+
+/**
+ * Lookup from modifier class and gameplay tag to the modifiers on a camera manager, owned by ACDPlayerCameraManager.
+ * Class buckets include subclasses and are built the first time a class is queried. Every bucket keeps the order of
+ * the modifier list. The whole index is invalidated when the modifier list changes.
+ */
+struct CAMERADYNAMICS_API FCDModifierIndex
+{
+	/** Counters for profiling how the index is used */
+	struct FStats
+	{
+		/** Number of queries made */
+		int32 Queries = 0;
+		/** Number of queries that had to build a class bucket */
+		int32 ClassBucketsBuilt = 0;
+		/** Number of modifiers checked against required tags */
+		int32 CandidatesTested = 0;
+		/** Number of times the index was rebuilt */
+		int32 Rebuilds = 0;
+	};
+
+	/** Mark the index as out of date, it is rebuilt on the next query */
+	void Invalidate() { bDirty = true; }
+
+	/** Get every modifier of a class (including subclasses) in modifier list order */
+	TConstArrayView<UCameraModifier*> GetModifiersOfClass(const TArray<TObjectPtr<UCameraModifier>>& ModifierList, const UClass* ModifierClass);
+
+	/**
+	 * Get the smallest set of modifiers that could match a query, in modifier list order.
+	 * Modifiers in the result still need to be checked with MatchesQuery.
+	 */
+	TConstArrayView<UCameraModifier*> GetCandidates(const TArray<TObjectPtr<UCameraModifier>>& ModifierList, const UClass* ModifierClass,
+	                                                const FGameplayTagContainer& RequiredTags, bool& bOutNeedsFilter);
+
+	/** Does a modifier match a class and tag query */
+	bool MatchesQuery(const UCameraModifier* Modifier, const UClass* ModifierClass, const FGameplayTagContainer& RequiredTags);
+
+	const FStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FStats(); }
+
+private:
+
+	void Rebuild(const TArray<TObjectPtr<UCameraModifier>>& ModifierList);
+
+	/** Modifiers for each queried class, including subclasses */
+	TMap<const UClass*, TArray<UCameraModifier*>> ByClass;
+
+	/** Modifiers for each gameplay tag, including the parents of each tag the modifier owns */
+	TMap<FGameplayTag, TArray<UCameraModifier*>> ByTag;
+
+	bool bDirty = true;
+	FStats Stats;
+};
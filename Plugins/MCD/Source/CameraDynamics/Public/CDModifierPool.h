@@ -0,0 +1,65 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CDModifierPool.generated.h"
+
+class UCDCameraModifierInstanced;
+
+/** Free runtime modifiers for a single source modifier */
+USTRUCT()
+struct FCDPooledModifierList
+{
+	GENERATED_BODY()
+
+	UPROPERTY() TArray<TObjectPtr<UCDCameraModifierInstanced>> Modifiers;
+};
+
+/**
+ * Pool of runtime camera modifiers owned by ACDPlayerCameraManager, keyed by the modifier on the camera data asset
+ * that they were duplicated from. Reused modifiers have their properties copied back from the source modifier, so they
+ * start in the same state as a fresh duplicate.
+ */
+USTRUCT()
+struct CAMERADYNAMICS_API FCDModifierPool
+{
+	GENERATED_BODY()
+
+	/** Maximum number of free modifiers kept for each source modifier. Extra modifiers are left for garbage collection. */
+	int32 MaxPooledPerSource = 4;
+
+	/**
+	 * Get a runtime modifier for a source modifier, reusing a pooled modifier if there is one.
+	 * @param SourceModifier - The modifier on the camera data asset.
+	 * @param Outer - The outer for newly duplicated modifiers.
+	 */
+	UCDCameraModifierInstanced* Acquire(UCDCameraModifierInstanced* SourceModifier, UObject* Outer);
+
+	/** Return a runtime modifier that has been removed from the camera manager. Returns false if it can't be pooled. */
+	bool Release(UCDCameraModifierInstanced* Modifier);
+
+	/** Duplicate modifiers ahead of time until there are at least Count free modifiers for this source */
+	void WarmUp(UCDCameraModifierInstanced* SourceModifier, UObject* Outer, int32 Count);
+
+	/** Drop all free modifiers and reset the counters */
+	void Empty();
+
+	/** Number of free modifiers across all sources */
+	int32 GetNumPooled() const;
+
+	/** Number of acquires that reused a pooled modifier */
+	int32 Hits = 0;
+
+	/** Number of acquires that had to duplicate a new modifier */
+	int32 Misses = 0;
+
+private:
+
+	UPROPERTY() TMap<TObjectPtr<UCDCameraModifierInstanced>, FCDPooledModifierList> FreeModifiers;
+
+	static UCDCameraModifierInstanced* Duplicate(UCDCameraModifierInstanced* SourceModifier, UObject* Outer);
+
+	/** Copy the source modifier's properties onto a pooled modifier */
+	static void CopyFromSource(const UCDCameraModifierInstanced* SourceModifier, UCDCameraModifierInstanced* Modifier);
+};
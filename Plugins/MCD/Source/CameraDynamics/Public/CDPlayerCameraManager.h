@@ -3,16 +3,120 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CDCameraFrameContext.h"
 #include "CDCameraStack.h"
+#include "CDModifierBatch.h"
+#include "CDModifierIndex.h"
+#include "CDModifierPool.h"
 #include "GameplayTagContainer.h"
 #include "Camera/PlayerCameraManager.h"
+#include "Modifiers/CDCameraModifier_Instanced.h"
 #include "CDPlayerCameraManager.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnViewTargetChangeStart, AActor*, NewViewTarget, FViewTargetTransitionParams, TransitionParams);
 
+class ACDPlayerCameraManager;
 class UCDCameraData;
 class UCDCameraModifierInstanced;
 
+/** A camera data add or removal waiting for the current stack transaction to be committed */
+USTRUCT()
+struct FCDPendingStackChange
+{
+	GENERATED_BODY()
+
+	UPROPERTY() TObjectPtr<UCDCameraData> CameraData;
+
+	/** The camera data instance being added or removed */
+	UPROPERTY() FCDCameraDataHandle Handle;
+
+	/** True to add the camera data, false to remove it */
+	UPROPERTY() bool bAdd = false;
+};
+
+/** Entry in a camera manager's camera data instance table, one for each time a camera data is added */
+USTRUCT()
+struct FCDCameraDataInstance
+{
+	GENERATED_BODY()
+
+	UPROPERTY() TObjectPtr<UCDCameraData> CameraData;
+
+	/**
+	 * Runtime modifier for each modifier in the camera data, parallel to UCDCameraData::CameraModifiers.
+	 * Compiled modifiers point at the program modifier that runs them.
+	 */
+	UPROPERTY() TArray<TObjectPtr<UCDCameraModifierInstanced>> RuntimeModifiers;
+
+	UPROPERTY() int32 Serial = 0;
+
+	/** Has the add been applied to the modifier list, false while it is waiting for a stack transaction */
+	UPROPERTY() bool bApplied = false;
+
+	/** Is a removal of this instance waiting for a stack transaction */
+	UPROPERTY() bool bPendingRemoval = false;
+
+	bool IsInUse() const { return CameraData != nullptr; }
+};
+
+/** Captures what a camera manager's pre-update needs on the game thread, once its pawn has finished moving */
+USTRUCT()
+struct FCDCameraCaptureTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	ACDPlayerCameraManager* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCDCameraCaptureTickFunction> : public TStructOpsTypeTraitsBase2<FCDCameraCaptureTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/** Runs a camera manager's pre-update on a worker thread once its frame context has been captured */
+USTRUCT()
+struct FCDCameraPreUpdateTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	ACDPlayerCameraManager* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCDCameraPreUpdateTickFunction> : public TStructOpsTypeTraitsBase2<FCDCameraPreUpdateTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/** Counters for the camera manager's modifier frame budget */
+struct FCDModifierBudgetStats
+{
+	int32 FramesMeasured = 0;
+	int32 FramesOverBudget = 0;
+	/** Frames where at least one modifier was deferred */
+	int32 FramesDegraded = 0;
+	int32 ModifiersDeferred = 0;
+	double TotalMicroseconds = 0.0;
+	float PeakMicroseconds = 0.0f;
+};
+
 /**
  * 
  */
@@ -26,13 +130,16 @@ public:
 	ACDPlayerCameraManager(const FObjectInitializer& ObjectInitializer);
 
 	virtual void InitializeFor(APlayerController* PC) override;
+
+	virtual void UpdateCamera(float DeltaTime) override;
 	
 	/**
 	 * Adds a specified camera data to the camera manager, blending in all the instanced camera modifiers.
 	 * @param NewCameraData - The camera data to add to the camera manager.
+	 * @return - Handle to this instance of the camera data, invalid if the camera data is invalid.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics")
-	void AddCameraData(UCDCameraData* NewCameraData);
+	FCDCameraDataHandle AddCameraData(UCDCameraData* NewCameraData);
 
 	/**
 	 * Removes a specific camera data from the camera manager, blending out all the instanced camera modifiers.
@@ -42,11 +149,51 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics")
 	bool RemoveCameraData(UCDCameraData* CameraData);
 
+	/**
+	 * Removes a specific instance of a camera data from the camera manager, blending out its instanced camera modifiers.
+	 * @param Handle - The handle returned when the camera data was added.
+	 * @return - True if the camera data was successfully removed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics")
+	bool RemoveCameraDataByHandle(FCDCameraDataHandle Handle);
+
+	/**
+	 * Get the runtime modifier created for a modifier in a camera data instance.
+	 * @param Handle - The handle returned when the camera data was added.
+	 * @param ModifierIndex - Index of the modifier in the camera data's CameraModifiers array.
+	 * @return - The runtime modifier, or null if there isn't one. Compiled modifiers return their program modifier.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics")
+	UCDCameraModifierInstanced* GetRuntimeModifier(FCDCameraDataHandle Handle, int32 ModifierIndex) const;
+
+	/** Is this handle for a camera data that is active, or waiting to be added, on this camera manager */
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics")
+	bool IsCameraDataHandleValid(FCDCameraDataHandle Handle) const { return FindInstance(Handle) != nullptr; }
+
 	/**
 	 * Removes all camera data from the camera manager, blending out all the instanced camera modifiers.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics")
 	void RemoveAllCameraData();
+
+	/**
+	 * Removes one camera data and adds another in a single stack transaction, so the modifier list is only sorted once.
+	 * @param OldCameraData - The camera data to remove. Can be null.
+	 * @param NewCameraData - The camera data to add. Can be null.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics")
+	void SwapCameraData(UCDCameraData* OldCameraData, UCDCameraData* NewCameraData);
+
+	/**
+	 * Start queueing camera data adds and removals. They are applied when the matching CommitStackTransaction is called,
+	 * with the modifier list sorted once and its priorities compacted. Transactions can be nested.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics")
+	void BeginStackTransaction();
+
+	/** Apply the camera data adds and removals queued since BeginStackTransaction */
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics")
+	void CommitStackTransaction();
 	
 	/**
 	 * The default camera data to be applied when this camera modifier is initialized.
@@ -62,9 +209,16 @@ public:
 	 */
 	UFUNCTION(BlueprintPure, Category = "Camera Dynamics")
 	TArray<UCDCameraData*> GetActiveCameraData() const { return CameraDataList; }
+
+	/**
+	 * Get all the active camera data without copying the list.
+	 * The view is only valid until camera data is added or removed.
+	 */
+	TConstArrayView<TObjectPtr<UCDCameraData>> GetActiveCameraDataView() const { return CameraDataList; }
 	
 	/**
 	 * Get the first active modifier of this type.
+	 * Uses the modifier index, so the cost doesn't grow with the number of active modifiers.
 	 * @param ModifierClass - The class of the modifier to get. 
 	 * @param RequiredTags - Any tags to require on the modifier. Will not search for tags if this is empty.
 	 * @return - Any valid found modifiers.
@@ -74,6 +228,7 @@ public:
 
 	/**
 	 * Get all active modifiers of this type.
+	 * Uses the modifier index, so only modifiers of the class (or with the required tags) are checked.
 	 * @param ModifierClass - The class of the modifier to get. 
 	 * @param RequiredTags - Any tags to require on the modifier. Will not search for tags if this is empty.
 	 * @return - All the valid found modifiers.
@@ -81,6 +236,65 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Camera Dynamics", meta = (DeterminesOutputType = "ModifierClass", AdvancedDisplay = "RequiredTags", AutoCreateRefTerm = "RequiredTags"))
 	TArray<UCameraModifier*> GetAllActiveModifiersOfClass(const TSubclassOf<UCameraModifier>& ModifierClass, const FGameplayTagContainer& RequiredTags);
 
+	/**
+	 * Get all active modifiers of this type without allocating, in modifier list order.
+	 * The view points into the modifier index and is only valid until the modifier list changes.
+	 */
+	TConstArrayView<UCameraModifier*> GetActiveModifiersOfClassView(const TSubclassOf<UCameraModifier> ModifierClass);
+
+	/**
+	 * Call a function on every active modifier of this type without allocating, in modifier list order.
+	 * Modifiers must not be added or removed from inside the visitor.
+	 * @param Visitor - Return false to stop visiting.
+	 */
+	void ForEachActiveModifierOfClass(const TSubclassOf<UCameraModifier> ModifierClass, const FGameplayTagContainer& RequiredTags,
+	                                  TFunctionRef<bool(UCameraModifier*)> Visitor);
+
+	/** Typed version of ForEachActiveModifierOfClass */
+	template<typename T>
+	void ForEachActiveModifierOfClass(const FGameplayTagContainer& RequiredTags, TFunctionRef<bool(T*)> Visitor)
+	{
+		ForEachActiveModifierOfClass(T::StaticClass(), RequiredTags, [&Visitor](UCameraModifier* Modifier)
+		{
+			return Visitor(static_cast<T*>(Modifier));
+		});
+	}
+
+	/**
+	 * Find a camera parameter declared by an added camera data. Find the handle once and keep it, handles stay valid
+	 * for the lifetime of this camera manager, even if the camera data declaring the parameter is removed.
+	 * @return - An invalid handle if the parameter isn't declared with this type.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics|Parameters")
+	FCDCameraParameterHandle FindCameraParameter(FName Name, TEnumAsByte<ECDCameraParameterType> Type) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Parameters")
+	void SetCameraParameterFloat(FCDCameraParameterHandle Handle, float Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Parameters")
+	void SetCameraParameterVector(FCDCameraParameterHandle Handle, FVector Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Parameters")
+	void SetCameraParameterRotator(FCDCameraParameterHandle Handle, FRotator Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Parameters")
+	void SetCameraParameterObject(FCDCameraParameterHandle Handle, UObject* Value);
+
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics|Parameters")
+	float GetCameraParameterFloat(FCDCameraParameterHandle Handle) const;
+
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics|Parameters")
+	FVector GetCameraParameterVector(FCDCameraParameterHandle Handle) const;
+
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics|Parameters")
+	FRotator GetCameraParameterRotator(FCDCameraParameterHandle Handle) const;
+
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics|Parameters")
+	UObject* GetCameraParameterObject(FCDCameraParameterHandle Handle) const;
+
+	/** Camera parameters declared by the added camera data. Write through the SetCameraParameter functions. */
+	const FCDCameraBlackboard& GetCameraBlackboard() const { return CameraBlackboard; }
+
 	/**
 	* If true, rotation inputs (from the player and any camera modifiers) will be combined with UCameraDynamicsFunctionLibrary::OrientationAwareRotationComposition.
 	* This is to prevent the camera from accumulating roll during modifier in/out blends.
@@ -95,9 +309,336 @@ public:
 
 	UPROPERTY(BlueprintAssignable, Category = "Camera Dynamics")
 	FOnViewTargetChangeStart OnViewTargetChangeStart;
+
+	/**
+	 * Tell a modifier when the view target changes, so it can blend out for view targets with its blend out tag.
+	 * Called by instanced modifiers when they are added to the camera. Modifiers are unsubscribed when removed.
+	 */
+	void SubscribeToViewTargetChange(UCDCameraModifierInstanced* Modifier);
+
+	void UnsubscribeFromViewTargetChange(UCDCameraModifierInstanced* Modifier);
+
+	/**
+	 * If true, native modifiers (Position Offset, Position Distance, FOV Adjust and Position Lag) are evaluated from
+	 * contiguous buffers owned by the camera manager instead of through each modifier object.
+	 * Blueprint subclasses of these modifiers always use the normal path.
+	 * Tuning values are captured when a modifier is added, so call RefreshBatchedModifier after changing them at runtime.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Camera Dynamics|Performance")
+	bool bUseBatchedModifierEvaluation;
+
+	/** Enable or disable batched evaluation of native modifiers at runtime */
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Performance")
+	void SetBatchedModifierEvaluation(bool bEnabled);
+
+	/**
+	 * Re-capture the tuning values of a modifier that is being evaluated by the batch.
+	 * Does nothing if the modifier isn't batched.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Performance")
+	void RefreshBatchedModifier(UCameraModifier* Modifier);
+
+	/**
+	 * Maximum number of removed runtime modifiers kept for reuse, per modifier on a camera data asset.
+	 * Reusing modifiers avoids duplicating them every time camera data is added.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Camera Dynamics|Performance", meta = (ClampMin = "0"))
+	int32 MaxPooledModifiersPerSource;
+
+	/**
+	 * Create runtime modifiers for a camera data ahead of time, so adding it later doesn't need to duplicate them.
+	 * @param CameraData - The camera data to warm up.
+	 * @param InstancesPerModifier - How many free runtime modifiers to have ready for each modifier in the camera data.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Performance")
+	void WarmUpCameraData(UCDCameraData* CameraData, int32 InstancesPerModifier = 1);
+
+	/**
+	 * Get the modifier pool counters.
+	 * @param Hits - Number of runtime modifiers that were reused from the pool.
+	 * @param Misses - Number of runtime modifiers that had to be duplicated.
+	 * @param NumPooled - Number of free runtime modifiers currently in the pool.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics|Performance")
+	void GetModifierPoolStats(int32& Hits, int32& Misses, int32& NumPooled) const;
+
+	/**
+	 * Rebuild the modifier index on the next query.
+	 * The index is updated when modifiers are added or removed, call this after changing a modifier's gameplay tags at runtime.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Performance")
+	void RefreshModifierIndex();
+
+	/**
+	 * Get the modifier index counters.
+	 * @param Queries - Number of class and tag queries made.
+	 * @param ClassBucketsBuilt - Number of queries that had to gather the modifiers of a class.
+	 * @param CandidatesTested - Number of modifiers checked against required tags.
+	 * @param Rebuilds - Number of times the index was rebuilt after the modifier list changed.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics|Performance")
+	void GetModifierIndexStats(int32& Queries, int32& ClassBucketsBuilt, int32& CandidatesTested, int32& Rebuilds) const;
+
+	/**
+	 * Step the batched modifiers on a worker thread before the camera update, in parallel with the other local players'
+	 * cameras. See UCDCameraUpdateSubsystem. Only does anything with bUseBatchedModifierEvaluation, and modifiers that
+	 * aren't batched are still evaluated serially in the camera update.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Camera Dynamics|Performance")
+	bool bParallelPreUpdate;
+
+	/**
+	 * Start the pre-update as soon as the controlled pawn's movement component has ticked, on a worker thread alongside
+	 * physics and animation. It always finishes before the camera update, so there is no added latency. Like
+	 * bParallelPreUpdate, it only steps the batched modifiers.
+	 * The frame context is captured on the game thread first, and captured again for the camera update itself.
+	 * Pawns without a movement component skip it, the camera update steps the batch instead.
+	 * Gameplay changes to the modifier stack wait for it if it is running. Only does anything with bUseBatchedModifierEvaluation.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Camera Dynamics|Performance")
+	bool bPreUpdateAfterPawnMovement;
+
+	/** Does this camera manager have any work for the parallel pre-update */
+	bool WantsParallelPreUpdate() const { return bParallelPreUpdate && bUseBatchedModifierEvaluation && !ModifierBatch.IsEmpty(); }
+
+	/** Capture the world state used by this frame's camera update. Game thread only. */
+	void CaptureFrameContext(float DeltaTime);
+
+	/**
+	 * Capture the frame context, and read the camera parameters and gameplay-driven values the pre-update steps the
+	 * batch with. Game thread only.
+	 */
+	void CapturePreUpdate(float DeltaTime);
+
+	/**
+	 * Step the batched modifiers from the values captured by CapturePreUpdate this frame. Only touches the batch's own
+	 * columns, never the modifier objects, so it is safe to run on a worker thread.
+	 */
+	void PreUpdateCamera();
+
+	virtual void RegisterActorTickFunctions(bool bRegister) override;
+
+	/** World state for the current camera update */
+	const FCDCameraFrameContext& GetFrameContext() const { return FrameContext; }
+
+	/**
+	 * Time budget for applying the camera modifiers each frame, in microseconds. 0 disables the budget.
+	 * When the modifiers are expected to go over budget, modifiers at or above DeferrableCostClass take turns being
+	 * evaluated, oldest first, and reuse their last change to the camera on the frames they are skipped.
+	 * The cost of each modifier is measured, and at least one deferred modifier is evaluated each frame,
+	 * so this is a target rather than a hard cap.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Camera Dynamics|Performance", meta = (ClampMin = "0.0", Units = "Microseconds"))
+	float ModifierBudgetMicroseconds;
+
+	/** Cheapest cost class that can be deferred when the modifiers are over budget */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Camera Dynamics|Performance")
+	TEnumAsByte<ECDModifierCostClass> DeferrableCostClass;
+
+	/** Maximum number of frames in a row a modifier can be deferred, however far over budget */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Camera Dynamics|Performance", meta = (ClampMin = "1"))
+	int32 MaxDeferredFrames;
+
+	/**
+	 * Get the modifier frame budget counters. Only counted while the budget is enabled.
+	 * @param FramesMeasured - Number of frames the budget was enabled for.
+	 * @param FramesOverBudget - Number of frames that took longer than the budget.
+	 * @param FramesDegraded - Number of frames where at least one modifier was deferred.
+	 * @param ModifiersDeferred - Total number of modifier evaluations that were deferred.
+	 * @param AverageMicroseconds - Average time taken to apply the modifiers.
+	 * @param PeakMicroseconds - Longest time taken to apply the modifiers.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics|Performance")
+	void GetModifierBudgetStats(int32& FramesMeasured, int32& FramesOverBudget, int32& FramesDegraded, int32& ModifiersDeferred,
+	                            float& AverageMicroseconds, float& PeakMicroseconds) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics|Performance")
+	void ResetModifierBudgetStats();
+
+	/**
+	 * Skip modifiers whose result is overwritten by the modifiers after them, such as FOV changes followed by a fully
+	 * blended in absolute FOV Adjust, or rotation modifiers followed by a Rotation Override.
+	 * Only native modifiers that declare the camera channels they read and write are skipped. Skipped modifiers keep
+	 * blending and resync their state when they are used again.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Camera Dynamics|Performance")
+	bool bSkipMaskedModifiers;
+
+	/** Called by instanced modifiers when they are marked for removal, they are removed once their alpha reaches zero */
+	void QueueModifierRemoval(UCDCameraModifierInstanced* Modifier);
+
+	/** Called by instanced modifiers when their target alpha or blend times change */
+	void OnModifierBlendStateChanged(UCDCameraModifierInstanced* Modifier);
+
+	virtual bool RemoveCameraModifier(UCameraModifier* ModifierToRemove) override;
+
+	virtual void ClearAllCameraModifiers() override;
+
+	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
+
+protected:
+
+	virtual bool AddCameraModifierToList(UCameraModifier* NewModifier) override;
+
+	virtual void ApplyCameraModifiers(float DeltaTime, FMinimalViewInfo& InOutPOV) override;
 	
 private:
 
+	/** Modifiers told about view target changes, each knows its own index for constant time removal */
+	UPROPERTY(Transient) TArray<TObjectPtr<UCDCameraModifierInstanced>> ViewTargetSubscribers;
+
+	/** Modifiers marked for removal that are still blending out */
+	UPROPERTY(Transient) TArray<TObjectPtr<UCDCameraModifierInstanced>> ModifiersPendingRemoval;
+
+	/** Remove the modifiers in ModifiersPendingRemoval that have finished blending out. Runs once per update. */
+	void RemoveFinishedModifiers();
+
+	/** Can the frame budget defer this modifier */
+	bool IsBudgetDeferrable(const UCDCameraModifierInstanced* Modifier) const;
+
+	/** Pick which deferrable modifiers are evaluated this frame, based on their measured cost and how long they've waited */
+	void ScheduleDeferrableModifiers();
+
+	FCDModifierBudgetStats BudgetStats;
+
+	/** Modifiers in ModifierList whose result is overwritten in the current pass, set by FindMaskedModifiers */
+	TBitArray<> MaskedModifiers;
+
+	/**
+	 * Walk the modifier list backwards, tracking which channels still reach the camera, and flag the modifiers that only
+	 * write channels later modifiers overwrite.
+	 * @param Pass - ECDCameraChannels::Pose for ApplyCameraModifiers, ECDCameraChannels::ViewRotation for ProcessViewRotation.
+	 */
+	void FindMaskedModifiers(ECDCameraChannels Pass, bool bUseBatch, bool bUseBudget);
+
+	/** Will this modifier replace the channels it overwrites this frame, rather than blend or reapply an earlier change */
+	bool IsOverwriting(UCDCameraModifierInstanced* Modifier, int32 ModifierIdx, ECDCameraChannels Pass, bool bUseBatch, bool bUseBudget) const;
+
+	/** Measured time taken last frame by everything the budget can't defer */
+	float FixedModifierCostMicroseconds;
+
+	/** Camera data changes queued by the current stack transaction, in the order they were made */
+	UPROPERTY(Transient) TArray<FCDPendingStackChange> PendingStackChanges;
+
+	/** Number of open stack transactions */
+	int32 StackTransactionDepth;
+
+	/** Add the runtime modifiers for a camera data instance to the end of the modifier list, without sorting it */
+	void ApplyCameraDataAdd(const FCDCameraDataHandle& Handle, TArray<UCDCameraModifierInstanced*, TInlineAllocator<16>>& OutAddedModifiers);
+
+	/** Mark the runtime modifiers for a camera data instance for removal and free the instance */
+	void ApplyCameraDataRemoval(const FCDCameraDataHandle& Handle);
+
+	/** Camera data instance table, indexed by FCDCameraDataHandle::Index */
+	UPROPERTY(Transient) TArray<FCDCameraDataInstance> CameraDataInstances;
+
+	/** Unused entries in CameraDataInstances */
+	TArray<int32> FreeCameraDataInstances;
+
+	/** Instances of each camera data, oldest first */
+	TMap<const UCDCameraData*, TArray<int32, TInlineAllocator<1>>> InstancesByCameraData;
+
+	FCDCameraDataHandle AllocateInstance(UCDCameraData* CameraData);
+	void FreeInstance(const FCDCameraDataHandle& Handle);
+	FCDCameraDataHandle GetInstanceHandle(int32 Index) const;
+	FCDCameraDataInstance* FindInstance(const FCDCameraDataHandle& Handle);
+	const FCDCameraDataInstance* FindInstance(const FCDCameraDataHandle& Handle) const;
+
+	/** Removed runtime modifiers waiting to be reused */
+	UPROPERTY(Transient) FCDModifierPool ModifierPool;
+
+	/** Hot state of the batched native modifiers */
+	FCDModifierBatch ModifierBatch;
+
+	/** Batch handle for each entry in ModifierList, invalid for modifiers using the normal path */
+	TArray<FCDBatchHandle> BatchOrder;
+
+	/** Set when ModifierList changes, so BatchOrder is rebuilt before the next evaluation */
+	bool bBatchOrderDirty;
+
+	/** Rebuild BatchOrder if the modifier list changed */
+	void RefreshBatchOrder();
+
+	/** Step the batch with the current frame context, and remember which snapshot it was stepped with */
+	void AdvanceBatch();
+
+	/**
+	 * Blend state of every instanced modifier that isn't batched, so their alphas can be stepped in a single pass over
+	 * packed arrays instead of a virtual UpdateAlpha per modifier. Parallel to PackedAlphaModifiers.
+	 */
+	FCDBatchBlendColumns PackedAlphas;
+	TArray<UCDCameraModifierInstanced*> PackedAlphaModifiers;
+
+	/** Set when ModifierList or batching changes, so the packed alphas are rebuilt before the next evaluation */
+	bool bPackedAlphasDirty;
+
+	/** Rebuild the packed alphas if the modifier list changed */
+	void RefreshPackedAlphas();
+
+	/** Step the alpha of every packed modifier and resolve its blended alpha, writing both back to the modifiers */
+	void StepPackedAlphas(float DeltaTime);
+
+	/**
+	 * Undo this frame's alpha step for the modifiers from FirstUnreached on, after a modifier stopped the update.
+	 * The base camera manager only updates the alphas of the modifiers it reaches.
+	 */
+	void RewindUnreachedAlphas(int32 FirstUnreached, bool bUseBatch);
+
+	/** Take a modifier out of the packed alphas, before it leaves the modifier list */
+	void ReleasePackedAlpha(UCDCameraModifierInstanced* Modifier);
+
+	FCDCameraFrameContext FrameContext;
+
+	/** Socket bones for the source positions of this camera's modifiers, kept across frame contexts */
+	FCDSocketCache SocketCache;
+
+	/** Camera parameters declared by the camera data added to this camera manager */
+	UPROPERTY(Transient) FCDCameraBlackboard CameraBlackboard;
+
+	/** Modifiers with inputs bound to camera parameters */
+	UPROPERTY(Transient) TArray<TObjectPtr<UCDCameraModifierInstanced>> ParameterReaders;
+
+	/** Is this handle valid for a parameter of this type, logging a warning if it isn't */
+	bool CheckParameterHandle(const FCDCameraParameterHandle& Handle, ECDCameraParameterType Type) const;
+
+	/** Resolve a modifier's parameter bindings against the blackboard, and have it read the current values */
+	void BindCameraParameters(UCDCameraModifierInstanced* Modifier);
+
+	/** Stop passing camera parameters to a modifier */
+	void UnbindCameraParameters(UCDCameraModifierInstanced* Modifier);
+
+	/** Pass written camera parameters to the modifiers bound to them, then clear the dirty bits */
+	void ReadCameraParameters();
+
+	FCDCameraCaptureTickFunction CaptureTickFunction;
+
+	FCDCameraPreUpdateTickFunction PreUpdateTickFunction;
+
+	/** The component CaptureTickFunction currently waits on */
+	TWeakObjectPtr<UActorComponent> PreUpdatePrerequisite;
+
+	/** Make the pre-update ticks wait on the movement of the currently controlled pawn, or disable them without one */
+	void UpdatePreUpdatePrerequisite();
+
+	/** Held by the pre-update, and by anything changing the modifier list or the batch while it could be running */
+	FCriticalSection PreUpdateCriticalSection;
+
+	/** Frame the batch was last stepped on, so a pre-updated batch isn't stepped again by ApplyCameraModifiers */
+	uint64 BatchAdvancedFrame;
+
+	/** Delta time and pawn of the snapshot the batch was last stepped with, a different snapshot steps it again */
+	float BatchAdvancedDeltaTime;
+	const APawn* BatchAdvancedPawn;
+
+	/** Frame CapturePreUpdate last gathered the batch on, the pre-update only steps the batch after it */
+	uint64 BatchGatheredFrame;
+
+	/** Lookup from class and gameplay tag to the modifiers in ModifierList */
+	FCDModifierIndex ModifierIndex;
+
+	/** Invalidate everything derived from ModifierList */
+	void OnModifierListChanged();
+
 	/** The camera data currently being used by the camera manager. */
 	UPROPERTY() TArray<TObjectPtr<UCDCameraData>> CameraDataList;
 };
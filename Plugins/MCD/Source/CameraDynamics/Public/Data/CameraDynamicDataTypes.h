@@ -5,6 +5,8 @@
 #include "Curves/CurveFloat.h"
 #include "CameraDynamicDataTypes.Generated.h"
 
+struct FCDCameraFrameContext;
+
 UENUM(BlueprintType)
 enum ECameraSourcePosition
 {
@@ -58,6 +60,12 @@ public:
      * @param Pawn - The pawn to use in finding the source position, if the source position requires a pawn
      */
     FVector FindSourcePosition(const TObjectPtr<APawn> Pawn) const;
+
+	/**
+	 * Find the source position for a camera from a frame context, without querying the pawn.
+	 * Socket positions still read the pawn's mesh, so this is game thread only.
+	 */
+	FVector FindSourcePosition(const FCDCameraFrameContext& Context) const;
 };
 
 /**
@@ -86,7 +94,7 @@ public:
         SocketOffset = FVector::ZeroVector;
 	}
 
-	FVector GetOffsetPosition(const FVector& SourcePosition, const FRotator& SourceRotation) const;
+	FVector GetOffsetPosition(const FVector& SourcePosition, const FQuat& SourceRotation) const;
 	
 };
 
@@ -18,6 +18,8 @@ public:
 
 	UCDCameraModifier_FOV_Adjust();
 
+	virtual void GetParameterBindings(TArray<const FCDCameraParameterBinding*>& OutBindings) const override;
+
 	/** Default value for the FOV change */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics")
 	float DefaultFOVChange;
@@ -26,6 +28,10 @@ public:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadWrite, Category = "Camera Dynamics")
     float TargetFOVChange;
 
+	/** Float camera parameter that drives TargetFOVChange */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics|Parameters")
+	FCDCameraParameterBinding TargetFOVChangeParameter;
+
 	/** Should the FOV change be smoothed */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Dynamics|Smoothing", meta = (InlineEditConditionToggle))
 	bool bUseSmoothing;
@@ -37,6 +43,8 @@ public:
 	TEnumAsByte<ECameraModOpType> ModificationType;
 
 private:
+
+	friend struct FCDModifierBatch;
 	
 	float FOVChange;
 	float ChangedFOV;	// Saved for debugging purposes
@@ -44,7 +52,14 @@ protected:
 
 	virtual void AddedToCamera(APlayerCameraManager* Camera) override;
 	
-	virtual void ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation, float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV) override;
+	virtual void ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose) override;
+
+	virtual void ReadParameters(const FCDCameraBlackboard& Blackboard) override;
+
+	virtual bool HasConverged() const override;
+	virtual void GetSleepInputs(FCDSleepInputs& OutInputs) const override;
+	virtual bool GetChannelUsage(FCDChannelUsage& OutUsage) const override;
+	virtual void UpdateMasked(ECDCameraChannels Pass, float DeltaTime) override;
 
 	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
 	
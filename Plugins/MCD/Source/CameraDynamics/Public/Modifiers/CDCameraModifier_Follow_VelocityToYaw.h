@@ -71,8 +71,16 @@ public:
 protected:
 
 	virtual bool ProcessViewRotationBlended(AActor* ViewTarget, float DeltaTime, FRotator& OutViewRotation, FRotator& OutDeltaRot) override;
+
+	virtual bool GetChannelUsage(FCDChannelUsage& OutUsage) const override;
+
+	virtual void UpdateMasked(ECDCameraChannels Pass, float DeltaTime) override;
 	
 	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
+
+	virtual void GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const override;
+
+	virtual void ResetForPool() override;
 private:
 
 	FRotator RotationInput;
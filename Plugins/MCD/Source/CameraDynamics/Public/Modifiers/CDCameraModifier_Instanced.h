@@ -4,6 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "CDBakedCurve.h"
+#include "CDCameraBlackboard.h"
+#include "CDCameraFrameContext.h"
+#include "CDCameraPose.h"
+#include "CDCameraStack.h"
 #include "Camera/CameraModifier.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Engine/Canvas.h"
@@ -32,6 +37,174 @@ enum ECameraModOpType
 	CMO_Multiplicative		UMETA(DisplayName = "Multiplicative")
 };
 
+/**
+ * How often a camera modifier is evaluated
+ */
+UENUM(BlueprintType, Category = "Camera Dynamics|Modifiers")
+enum ECDModifierUpdateRate
+{
+	CMUR_EveryFrame			UMETA(DisplayName = "Every Frame"),
+	CMUR_EveryNFrames		UMETA(DisplayName = "Every N Frames"),
+	CMUR_FixedRate			UMETA(DisplayName = "Fixed Rate")
+};
+
+/**
+ * Rough cost of evaluating a camera modifier, cheapest first
+ */
+UENUM(BlueprintType, Category = "Camera Dynamics|Modifiers")
+enum ECDModifierCostClass
+{
+	CMCC_Math				UMETA(DisplayName = "Pure Math"),
+	CMCC_Curve				UMETA(DisplayName = "Curve Evaluation"),
+	CMCC_WorldQuery			UMETA(DisplayName = "World Query"),
+	CMCC_Blueprint			UMETA(DisplayName = "Blueprint")
+};
+
+/**
+ * Tracks when a reduced rate modifier is next due to be evaluated, and how far it is between evaluations
+ */
+struct FCDUpdateRateTimer
+{
+	float TimeSinceUpdate = 0.0f;
+	int32 FramesSinceUpdate = 0;
+	/** Time between the last two evaluations */
+	float LastInterval = 0.0f;
+	bool bHasUpdated = false;
+
+	/** Advance by one frame. Returns true if the modifier should be evaluated this frame. */
+	bool Tick(const float DeltaTime, const ECDModifierUpdateRate Rate, const int32 EveryNFrames, const float RateHz)
+	{
+		TimeSinceUpdate += DeltaTime;
+		++FramesSinceUpdate;
+		if (!bHasUpdated) return true;
+
+		switch (Rate)
+		{
+		case CMUR_EveryNFrames:	return FramesSinceUpdate >= FMath::Max(EveryNFrames, 1);
+		case CMUR_FixedRate:	return TimeSinceUpdate >= 1.0f / FMath::Max(RateHz, UE_KINDA_SMALL_NUMBER);
+		default:				return true;
+		}
+	}
+
+	/** Start a new interval after evaluating. Returns the time since the previous evaluation. */
+	float ConsumeUpdate()
+	{
+		const float Elapsed = TimeSinceUpdate;
+		LastInterval = TimeSinceUpdate;
+		TimeSinceUpdate = 0.0f;
+		FramesSinceUpdate = 0;
+		bHasUpdated = true;
+		return Elapsed;
+	}
+
+	/** How far through the current interval we are, based on the length of the last one */
+	float GetIntervalFraction() const
+	{
+		return LastInterval > 0.0f ? FMath::Min(TimeSinceUpdate / LastInterval, 1.0f) : 1.0f;
+	}
+
+	void Reset() { *this = FCDUpdateRateTimer(); }
+};
+
+/**
+ * Per modifier state for the camera manager's frame budget
+ */
+struct FCDModifierBudgetState
+{
+	/** The change made to the camera pose by the last evaluation, reused on frames the modifier is deferred */
+	FCDPoseDelta LastPoseDelta;
+	/** Smoothed measured cost of an evaluation */
+	float AverageCostMicroseconds = 0.0f;
+	/** Time skipped since the last evaluation, passed on to the next one */
+	float DeferredTime = 0.0f;
+	int32 FramesDeferred = 0;
+	bool bHasOutput = false;
+	bool bEvaluateThisFrame = true;
+
+	/** Record an evaluation of the modifier */
+	void Record(const FCDCameraPose& ViewPose, const FCDCameraPose& NewPose, const float CostMicroseconds)
+	{
+		LastPoseDelta = FCDPoseDelta::Between(ViewPose, NewPose);
+		AverageCostMicroseconds = bHasOutput ? FMath::Lerp(AverageCostMicroseconds, CostMicroseconds, 0.1f) : CostMicroseconds;
+		FramesDeferred = 0;
+		bHasOutput = true;
+	}
+};
+
+/**
+ * What a modifier's result depends on, so the camera manager knows when to wake it after it has converged
+ */
+struct FCDSleepInputs
+{
+	/** Parts of the incoming camera pose the result depends on */
+	bool bLocation = false;
+	bool bRotation = false;
+	bool bFOV = false;
+	/** Other values the result depends on, such as targets set by gameplay */
+	TArray<float, TInlineAllocator<4>> Values;
+	/** How far each value can drift before the modifier wakes, parallel to Values */
+	TArray<float, TInlineAllocator<4>> Tolerances;
+
+	/** Add a value the result depends on. Any change wakes the modifier unless a tolerance in the value's units is given. */
+	void AddValue(const float Value, const float Tolerance = 0.0f)
+	{
+		Values.Add(Value);
+		Tolerances.Add(Tolerance);
+	}
+
+	/** Add a flag the result depends on, any change wakes the modifier */
+	void AddFlag(const bool bValue) { AddValue(bValue ? 1.0f : 0.0f); }
+};
+
+/**
+ * Per modifier state for convergence sleep. A sleeping modifier isn't evaluated, its last change to the camera pose
+ * is applied instead until one of its inputs changes.
+ */
+struct FCDModifierSleepState
+{
+	/** The change made to the camera pose by the evaluation the modifier fell asleep after */
+	FCDPoseDelta PoseDelta;
+	/** The incoming camera pose and inputs of that evaluation */
+	FCDCameraPose InputPose;
+	FCDSleepInputs Inputs;
+	float Alpha = 0.0f;
+	bool bAsleep = false;
+	int32 SleepCount = 0;
+	int32 WakeCount = 0;
+};
+
+/**
+ * Parts of the camera a modifier can read and write
+ */
+enum class ECDCameraChannels : uint8
+{
+	None			= 0,
+	Location		= 1 << 0,
+	Rotation		= 1 << 1,
+	FOV				= 1 << 2,
+	/** The view rotation and delta rotation handled by ProcessViewRotation */
+	ViewRotation	= 1 << 3,
+
+	/** Channels of the camera pose, handled by ModifyCamera */
+	Pose			= Location | Rotation | FOV,
+	All				= Pose | ViewRotation
+};
+ENUM_CLASS_FLAGS(ECDCameraChannels);
+
+/**
+ * Camera channels a modifier reads and writes, so the camera manager can skip modifiers whose result is overwritten
+ * by the modifiers after them
+ */
+struct FCDChannelUsage
+{
+	/** Channels the result depends on */
+	ECDCameraChannels Reads = ECDCameraChannels::None;
+	/** Channels the modifier can change */
+	ECDCameraChannels Writes = ECDCameraChannels::None;
+	/** Written channels that are replaced whatever their incoming value, when the modifier is fully blended in */
+	ECDCameraChannels Overwrites = ECDCameraChannels::None;
+};
+
 class UCDCameraData;
 class ACharacter;
 
@@ -65,6 +238,9 @@ public:
 	/** Camera data asset that this modifier is sourced from */
 	TWeakObjectPtr<UCDCameraData> CameraDataSource;
 
+	/** Handle of the camera data instance on the camera manager that added this runtime modifier */
+	FCDCameraDataHandle CameraDataHandle;
+
 	/** Name for this modifier that will be shown in the simplified editor and in some debug displays */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	FText FriendlyName;
@@ -107,14 +283,87 @@ public:
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "CameraModifier|Blend")
 	bool bWatchForViewTargetChange;
+
+	/**
+	 * How often this modifier is evaluated. Between evaluations, the change this modifier made to the camera is
+	 * interpolated between its last two results, which saves the cost of expensive modifiers at high frame rates.
+	 * Modifiers that aren't evaluated every frame aren't batched or compiled into camera programs.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "CameraModifier|Performance")
+	TEnumAsByte<ECDModifierUpdateRate> UpdateRate;
+
+	/** Number of frames between evaluations */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "CameraModifier|Performance",
+		meta = (ClampMin = "1", EditCondition = "UpdateRate == ECDModifierUpdateRate::CMUR_EveryNFrames", EditConditionHides))
+	int32 UpdateEveryNFrames;
+
+	/** Evaluations per second */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "CameraModifier|Performance",
+		meta = (ClampMin = "1.0", Units = "Hz", EditCondition = "UpdateRate == ECDModifierUpdateRate::CMUR_FixedRate", EditConditionHides))
+	float UpdateRateHz;
+
+	/**
+	 * Rough cost of evaluating this modifier. When the camera manager has a frame budget, modifiers at or above its
+	 * deferrable cost class are spread across frames when over budget. Blueprint subclasses always count as Blueprint.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "CameraModifier|Performance")
+	TEnumAsByte<ECDModifierCostClass> CostClass;
+
+	/** Get the cost class used by the frame budget */
+	ECDModifierCostClass GetCostClass() const
+	{
+		return GetClass()->HasAnyClassFlags(CLASS_Native) ? CostClass.GetValue() : CMCC_Blueprint;
+	}
+
+	/**
+	 * Extrapolate from the last two results between evaluations, instead of interpolating between them.
+	 * Interpolating is always smooth but is an evaluation behind, extrapolating has no delay but can overshoot.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "CameraModifier|Performance",
+		meta = (EditCondition = "UpdateRate != ECDModifierUpdateRate::CMUR_EveryFrame"))
+	bool bExtrapolateBetweenUpdates;
+
+	/**
+	 * Let the camera manager skip this modifier once it has converged, reapplying its last change to the camera until
+	 * one of its inputs changes, see SleepWakeThreshold. Only native modifiers that report convergence sleep,
+	 * batched and reduced rate modifiers are always evaluated.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "CameraModifier|Performance")
+	bool bAllowSleep;
+
+	/**
+	 * How close to its target the modifier has to be to sleep, and how far the incoming camera can drift while it sleeps.
+	 * In cm for the location, and degrees for the rotation and FOV. Other declared inputs, such as targets, wake it on any change.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "CameraModifier|Performance", meta = (ClampMin = "0.0", EditCondition = "bAllowSleep"))
+	float SleepWakeThreshold;
+
+	/** Is this modifier converged and being skipped by the camera manager */
+	UFUNCTION(BlueprintPure, Category = "CameraModifier|Performance")
+	bool IsAsleep() const { return SleepState.bAsleep; }
+
+	/** Evaluate this modifier again from the next camera update, for changes its sleep inputs don't cover */
+	UFUNCTION(BlueprintCallable, Category = "CameraModifier|Performance")
+	void WakeUp();
 	
 	virtual void UpdateAlpha(float DeltaTime) override;
 
-	/** Start a timer to remove this modifier after the blend out time */
+	/** Blend this modifier out. The camera manager removes it once its alpha reaches zero. */
 	virtual void MarkForRemoval();
+
+	/**
+	 * Bake this modifier's curves into lookup tables, see FCDBakedCurve. Modifiers on camera data are baked when it is
+	 * loaded or edited, runtime modifiers share their bakes when they are added to the camera. Call this after changing
+	 * curves at runtime.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "CameraModifier|Performance")
+	void RefreshBakedCurves();
+
+	/** Get one of this modifier's curves with its baked version, or on its own if it isn't baked */
+	FCDCurveRef GetBakedCurve(const FRuntimeFloatCurve& Curve) const;
 	
-	/** Runtime version of this camera modifier. */
-	TWeakObjectPtr<UCDCameraModifierInstanced> RuntimeModifier;
+	/** The modifier on the camera data asset that this runtime modifier was created from. */
+	TWeakObjectPtr<UCDCameraModifierInstanced> SourceModifier;
 	
 protected:
 
@@ -136,6 +385,12 @@ protected:
 	/** Get the player controller that owns the camera manager associated with this modifier */
 	UFUNCTION(BlueprintPure, Category = "Camera Dynamics")
 	APlayerController* GetOwnerController() const;
+
+	/**
+	 * World state for the current camera update, shared by every modifier on a CD camera manager.
+	 * Prefer this over querying the controller and pawn in native modifiers.
+	 */
+	const FCDCameraFrameContext& GetFrameContext() const;
 	
 	/** Returns true if the camera debugger is open (ShowDebug Camera) */
 	UFUNCTION(BlueprintPure, Category = "Camera Dynamics")
@@ -154,6 +409,8 @@ protected:
 	
 	
 	virtual void EnableModifier() override;
+
+	virtual void DisableModifier(bool bImmediate = false) override;
 	
 	virtual auto ModifyCamera(float DeltaTime, FVector ViewLocation, FRotator ViewRotation, float FOV,
 	                          FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV) -> void override;
@@ -165,9 +422,24 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCosmetic, Category = "Camera Dynamics")
 	void BlueprintAddedToCamera(APlayerCameraManager* Camera);
 	
-	// Modifies the camera the same as ModifyCamera, but is automatically blended with the alpha value
-	virtual void ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation, float FOV,
-							  FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV);
+	/**
+	 * Modify the camera pose, then blend the result with the alpha of this modifier.
+	 * Override ModifyCameraBlended instead, unless the modifier shouldn't be blended.
+	 */
+	virtual void ModifyPose(float DeltaTime, FCDCameraPose& InOutPose);
+
+	/**
+	 * Modifies the camera the same as ModifyCamera, but is automatically blended with the alpha value.
+	 * @param ViewPose - The camera pose at the start of this modifier's application.
+	 * @param InOutPose - The new camera pose to be applied by this modifier, starts as ViewPose.
+	 */
+	virtual void ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose);
+
+	/**
+	 * Same as UCameraModifier::ModifyCamera, using a camera pose instead of an FMinimalViewInfo.
+	 * Used by the camera manager for native modifiers, Blueprint modifiers go through ModifyCamera.
+	 */
+	virtual bool ModifyCameraPose(float DeltaTime, FCDCameraPose& InOutPose);
 
 
 	/**
@@ -225,6 +497,9 @@ protected:
 	/** Get the value of a runtime float curve at a given time. Wraps the function library version. */
 	UFUNCTION(BlueprintPure, Category = "Camera Dynamics")
 	static float GetRuntimeFloatCurveValue(const FRuntimeFloatCurve& Curve, const float InTime);
+
+	/** Evaluate one of this modifier's curves, using its baked version if there is one */
+	float EvalBakedCurve(const FRuntimeFloatCurve& Curve, const float InTime) const;
 	
 	/** Draw debug text on the canvas at a world location and optional offset */
 	static void DrawDebugTextProjected(TObjectPtr<UCanvas> Canvas, const UFont* DrawFont, const FString& Text,
@@ -233,6 +508,65 @@ protected:
 	
 	/** Remove this camera modifier from the camera modifier list */
 	virtual void RemoveSelfFromModifierList();
+
+	/**
+	 * Called when this runtime modifier is returned to the camera manager's modifier pool.
+	 * Reset any runtime state that isn't a property and isn't set up again in AddedToCamera.
+	 */
+	virtual void ResetForPool();
+
+	/** Can the camera manager step this modifier's alpha in its packed alpha pass. False for modifiers that override UpdateAlpha. */
+	virtual bool UsesPackedAlpha() const { return true; }
+
+	/** Add the curves this modifier evaluates during the camera update, to be baked. Overrides should call Super. */
+	virtual void GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const;
+
+	/**
+	 * Has this modifier reached a steady state, where evaluating it again with the same inputs makes the same change
+	 * to the camera. Checked after each evaluation when bAllowSleep is set.
+	 */
+	virtual bool HasConverged() const { return false; }
+
+	/** Declare what this modifier's result depends on while it is converged. Overrides should call Super. */
+	virtual void GetSleepInputs(FCDSleepInputs& OutInputs) const {}
+
+	/**
+	 * Declare the camera channels this modifier reads and writes with its current settings, so the camera manager can
+	 * skip it while later modifiers overwrite everything it writes. Only used for native modifiers.
+	 * @return - False if the usage isn't known, in which case the modifier is always evaluated and is assumed to read
+	 * every channel and to be able to stop the modifiers after it.
+	 */
+	virtual bool GetChannelUsage(FCDChannelUsage& OutUsage) const { return false; }
+
+	/**
+	 * Called in place of evaluating this modifier while its result is overwritten by later modifiers.
+	 * Step any state that doesn't depend on the incoming camera, so it is current when the modifier is used again.
+	 * @param Pass - ECDCameraChannels::Pose for the camera pose, ECDCameraChannels::ViewRotation for ProcessViewRotation.
+	 */
+	virtual void UpdateMasked(ECDCameraChannels Pass, float DeltaTime) {}
+
+	/**
+	 * Called before the first evaluation after this modifier was masked, to resync state that follows the incoming camera.
+	 * @param ViewPose - The incoming camera pose. For the view rotation, the camera location with the view rotation.
+	 */
+	virtual void ResumeFromMasked(ECDCameraChannels Pass, const FCDCameraPose& ViewPose) {}
+
+public:
+
+	/** Add the inputs of this modifier that can be bound to camera parameters. Overrides should call Super. */
+	virtual void GetParameterBindings(TArray<const FCDCameraParameterBinding*>& OutBindings) const {}
+
+	/** Is any input of this modifier bound to a camera parameter */
+	bool HasParameterBindings() const;
+
+protected:
+
+	/**
+	 * Read bound camera parameters into this modifier's inputs. Called by the camera manager before the modifiers are
+	 * evaluated, only when a bound parameter has been written or a binding was just resolved.
+	 * Use FCDCameraBlackboard::Read, which skips parameters that haven't changed. Overrides should call Super.
+	 */
+	virtual void ReadParameters(const FCDCameraBlackboard& Blackboard) {}
 	
 	/**
 	 * Get the alpha value for the current blend, based on the appropriate custom blend
@@ -252,11 +586,120 @@ protected:
 
 	UFUNCTION(BlueprintCallable, Category = "Camera Dynamics")
 	void ResetBlendState();
+
+	/**
+	 * Alpha after custom blend curves for the current blend direction. Only resolved again when the alpha or the blend
+	 * direction changes, so ModifyPose and ProcessViewRotation share a single curve evaluation.
+	 */
+	float GetBlendedAlpha() const;
+
+	/** Blend time set by BlendToNewTargetAlpha, or < 0 if there isn't one */
+	float GetCustomTargetBlendTime() const { return CustomTargetBlendTime; }
+
+	/** Is this modifier evaluated less often than every frame */
+	bool IsReducedRate() const { return UpdateRate != CMUR_EveryFrame; }
+
+	/** Advance a timer using this modifier's update rate. Returns true if the modifier should be evaluated this frame. */
+	bool TickUpdateRate(FCDUpdateRateTimer& Timer, const float DeltaTime) const
+	{
+		return Timer.Tick(DeltaTime, UpdateRate, UpdateEveryNFrames, UpdateRateHz);
+	}
 	
 private:
 
-	UFUNCTION()
-	void OnViewTargetChangeStart(AActor* NewViewTarget, FViewTargetTransitionParams TransitionParams);
+	friend class ACDPlayerCameraManager;
+	friend struct FCDModifierBatch;
+	friend struct FCDBatchBlendColumns;
+	friend struct FCDModifierPool;
+	friend struct FCDCameraProgram;
+
+	/** Tell the owning camera manager that the target alpha or blend times of this modifier have changed */
+	void NotifyBlendStateChanged();
+
+	/**
+	 * Called by the camera manager when the view target changes, if this modifier is subscribed.
+	 * @param bViewTargetHasBlendOutTag - Does the new view target have ViewTargetBlendOutTag.
+	 * @param BlendTime - Blend time of the view target transition.
+	 */
+	void OnViewTargetChangeStart(bool bViewTargetHasBlendOutTag, float BlendTime);
+
+	/** Index in the camera manager's view target subscribers, or INDEX_NONE */
+	int32 ViewTargetSubscriberIndex;
+
+	/**
+	 * Run ModifyPose at this modifier's update rate, applying the interpolated result of the last evaluations on the
+	 * frames in between.
+	 */
+	void EvaluatePose(float DeltaTime, FCDCameraPose& InOutPose);
+
+	/** Reuse the last evaluation's change to the camera pose, for frames the camera manager's budget defers this modifier */
+	void ReuseLastPose(float DeltaTime, FCDCameraPose& InOutPose);
+
+	FCDModifierBudgetState BudgetState;
+
+	FCDModifierSleepState SleepState;
+
+	/** Can this modifier sleep once it has converged */
+	bool CanSleep() const;
+
+	/** Put this modifier to sleep after an evaluation, if it has converged and isn't blending */
+	void TrySleep(const FCDCameraPose& ViewPose, const FCDCameraPose& NewPose);
+
+	/** Has an input of this sleeping modifier changed beyond the threshold since it fell asleep */
+	bool ShouldWake(const FCDCameraPose& ViewPose) const;
+
+	/** Apply the sleeping modifier's change to the camera pose, in place of evaluating it */
+	void ApplySleepingPose(float DeltaTime, FCDCameraPose& InOutPose);
+
+	/** Passes of the camera update this modifier is being skipped in, because later modifiers overwrite its result */
+	ECDCameraChannels MaskedPasses;
+
+	bool IsMasked(const ECDCameraChannels Pass) const { return EnumHasAnyFlags(MaskedPasses, Pass); }
+
+	/** Skip a pass while masked, keeping the blend and the modifier's own state up to date */
+	void SkipMasked(ECDCameraChannels Pass, float DeltaTime);
+
+	/** Resync a masked modifier's state before it is evaluated again in a pass */
+	void Unmask(ECDCameraChannels Pass, const FCDCameraPose& ViewPose);
+
+	/** Set the alpha along with its blended alpha, when it has been stepped by the camera manager or the batch */
+	void SetResolvedAlpha(float NewAlpha, float NewBlendedAlpha);
+
+	/** Slot in the camera manager's packed alpha columns, or INDEX_NONE */
+	int32 PackedAlphaSlot;
+
+	/** Set when the packed alpha pass has stepped the alpha this frame, so UpdateAlpha doesn't step it again */
+	bool bAlphaSteppedByCamera;
+
+	/** Cache for GetBlendedAlpha, with the alpha and blend direction it was resolved for */
+	mutable float CachedBlendedAlpha;
+	mutable float CachedBlendedAlphaSource;
+	mutable bool bCachedBlendedAlphaBlendIn;
+
+	/** Blackboard slots of the bound parameters, set by the camera manager when it resolves the bindings */
+	TArray<int32, TInlineAllocator<2>> BoundParameterSlots;
+
+	/** Frame context captured by this modifier, when its camera manager doesn't provide one */
+	mutable FCDCameraFrameContext FallbackFrameContext;
+
+	/** A curve reported by GetCurvesToBake, with its baked version */
+	struct FBakedCurveEntry
+	{
+		const FRuntimeFloatCurve* Source = nullptr;
+		FCDCurveRef Curve;
+	};
+
+	/** Find the bake of a curve with the same keys as this one, so runtime modifiers can share their source's bakes */
+	TSharedPtr<const FCDBakedCurve> FindMatchingBake(const FRichCurve& Curve) const;
+
+	/** Set by RefreshBakedCurves, the entries are looked up linearly as there are only ever a few */
+	TArray<FBakedCurveEntry, TInlineAllocator<4>> BakedCurves;
+	bool bCurvesBaked;
+
+	FCDUpdateRateTimer PoseUpdateTimer;
+	/** Changes made to the camera pose by the last two evaluations, when running at a reduced rate */
+	FCDPoseDelta PreviousPoseDelta;
+	FCDPoseDelta LatestPoseDelta;
 
 	float CustomTargetBlendAlpha;
 	float CustomTargetBlendTime;
@@ -266,7 +709,6 @@ private:
 	bool bDrawDebugInfoThisFrame;
 	
 	bool bMarkedForRemoval;
-	FTimerHandle RemovalTimerHandle;
 
 	// The alpha value that the modifier had before it was blended out due to a view target change with a matching tag
 	// This is used to blend back in when the view target changes back to one with the matching tag
@@ -282,9 +724,15 @@ private:
 protected:
 	virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent) override;
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+public:
+	/**
+	 * Runtime modifiers created from this modifier on the camera data asset, used to copy edits made during PIE.
+	 * There can be more than one, as each camera manager creates its own runtime modifiers.
+	 */
+	TArray<TWeakObjectPtr<UCDCameraModifierInstanced>> EditorRuntimeModifiers;
 private:
 	FTimerHandle CopyPropertiesTimerHandle;
-	void CopyPropertiesToRuntimeModifier();
+	void CopyPropertiesToRuntimeModifiers();
 	
 	#endif
 
@@ -29,8 +29,9 @@ public:
 	
 protected:
 	
-	virtual void ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation, float FOV,
-	                                 FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV) override;
+	virtual void ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose) override;
+
+	virtual bool GetChannelUsage(FCDChannelUsage& OutUsage) const override;
 
 	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
 	
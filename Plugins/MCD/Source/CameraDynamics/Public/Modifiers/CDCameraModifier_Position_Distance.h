@@ -19,10 +19,16 @@ public:
 
 	UCDCameraModifier_Position_Distance();
 
+	virtual void GetParameterBindings(TArray<const FCDCameraParameterBinding*>& OutBindings) const override;
+
 	/** The target distance for this offset, in the camera's X vector */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics")
 	float TargetDistance;
 
+	/** Float camera parameter that drives TargetDistance */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics|Parameters")
+	FCDCameraParameterBinding TargetDistanceParameter;
+
 	/** Should changes in the target distance value be smoothed */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Smoothing", meta = (InlineEditConditionToggle))
 	bool bSmoothDistanceChanges;
@@ -33,11 +39,18 @@ public:
 	
 private:
 
+	friend struct FCDModifierBatch;
+
 	float Distance;
 	
 protected:
 
 	virtual void AddedToCamera(APlayerCameraManager* Camera) override;
-	virtual void ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation, float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV) override;
+	virtual void ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose) override;
+	virtual void ReadParameters(const FCDCameraBlackboard& Blackboard) override;
+	virtual bool HasConverged() const override;
+	virtual void GetSleepInputs(FCDSleepInputs& OutInputs) const override;
+	virtual bool GetChannelUsage(FCDChannelUsage& OutUsage) const override;
+	virtual void UpdateMasked(ECDCameraChannels Pass, float DeltaTime) override;
 	
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/HitResult.h"
+#include "CDCameraKernels.h"
 #include "Modifiers/CDCameraModifier_Instanced.h"
 #include "CDCameraModifier_Position_DynamicZ.generated.h"
 
@@ -42,15 +43,27 @@ public:
 	
 	UFUNCTION()
 	void OnCharacterLanded(const FHitResult& Hit);
+
+	/** Flatten the tuning values of this modifier for the shared dynamic Z kernel */
+	CDCameraKernels::FDynamicZParams MakeDynamicZParams() const;
 protected:
 	
 	virtual void AddedToCamera(APlayerCameraManager* Camera) override;
 
-	virtual void ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation, float FOV, FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV) override;
+	virtual void ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose) override;
 
 	virtual void RemoveSelfFromModifierList() override;
+
+	virtual void ResetForPool() override;
 	
 	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
+
+	virtual void GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const override;
+
+	virtual bool HasConverged() const override;
+	virtual void GetSleepInputs(FCDSleepInputs& OutInputs) const override;
+	virtual bool GetChannelUsage(FCDChannelUsage& OutUsage) const override;
+	virtual void ResumeFromMasked(ECDCameraChannels Pass, const FCDCameraPose& ViewPose) override;
 	
 private:
 	
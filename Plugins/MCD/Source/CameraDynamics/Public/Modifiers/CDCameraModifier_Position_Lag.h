@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CDCameraKernels.h"
 #include "CDCameraModifier_Instanced.h"
 #include "Data/CameraDynamicDataTypes.h"
 #include "CDCameraModifier_Position_Lag.generated.h"
@@ -66,19 +67,30 @@ public:
 	/** The influence that the delta yaw of the camera has on the lag interpolation speed. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Dynamics|Delta Rotation", meta = (EditCondition = "bVelocityInfluencesRotInterpSpeed"))
 	FCDCameraAxisData DeltaYawVelocityAxisInfluence;
+
+	/** Flatten the tuning values of this modifier for CDCameraKernels::StepPositionLag */
+	CDCameraKernels::FLagParams MakeLagParams() const;
 	
 protected:
 
 	virtual void AddedToCamera(APlayerCameraManager* Camera) override;
-	virtual void ModifyCameraBlended(float DeltaTime, FVector ViewLocation, FRotator ViewRotation, float FOV,
-	                                 FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV) override;
+	virtual void ModifyCameraBlended(float DeltaTime, const FCDCameraPose& ViewPose, FCDCameraPose& InOutPose) override;
 	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
+
+	virtual void GetCurvesToBake(TArray<const FRuntimeFloatCurve*>& OutCurves) const override;
+
+	virtual bool HasConverged() const override;
+	virtual void GetSleepInputs(FCDSleepInputs& OutInputs) const override;
+	virtual bool GetChannelUsage(FCDChannelUsage& OutUsage) const override;
+	virtual void ResumeFromMasked(ECDCameraChannels Pass, const FCDCameraPose& ViewPose) override;
 	
 private:
 
+	friend struct FCDModifierBatch;
+
 	float InterpSpeed;
 	float DistanceToTarget;
 	FVector CameraPositionTarget;
 	FVector LaggedCameraPosition;
-	FRotator LastFrameRotation;
+	FQuat LastFrameRotation;
 };
@@ -0,0 +1,56 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CDCameraProgram.h"
+#include "Modifiers/CDCameraModifier_Instanced.h"
+#include "CDCameraModifier_Program.generated.h"
+
+/**
+ * Runs a contiguous range of modifiers from a compiled camera data program.
+ * Created by the camera manager when camera data with bCompileCameraProgram is added, and shouldn't be added to camera data directly.
+ * Each compiled modifier keeps its own alpha, so blending matches the modifiers it was compiled from.
+ */
+UCLASS(NotBlueprintable, HideDropdown, DisplayName = "Camera Modifier - Compiled Program")
+class CAMERADYNAMICS_API UCDCameraModifier_Program : public UCDCameraModifierInstanced
+{
+	GENERATED_BODY()
+
+public:
+
+	UCDCameraModifier_Program();
+
+	/**
+	 * Set up this modifier to run part of a compiled program.
+	 * @param InProgram - The compiled program, kept alive by this modifier.
+	 * @param InRunIndex - The run of the program to evaluate.
+	 * @param FirstSourceModifier - The first modifier of the run, used for the view target blend settings.
+	 */
+	void InitializeProgram(const TSharedRef<const FCDCameraProgram>& InProgram, int32 InRunIndex,
+	                       const UCDCameraModifierInstanced* FirstSourceModifier);
+
+	virtual void UpdateAlpha(float DeltaTime) override;
+
+protected:
+
+	virtual void AddedToCamera(APlayerCameraManager* Camera) override;
+
+	// Fully overridden, since each compiled modifier is blended by its own alpha rather than the alpha of this modifier
+	virtual void ModifyPose(float DeltaTime, FCDCameraPose& InOutPose) override;
+
+	virtual bool ProcessViewRotation(AActor* ViewTarget, float DeltaTime, FRotator& OutViewRotation, FRotator& OutDeltaRot) override;
+
+	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
+
+	// Each compiled modifier has its own alpha, stepped in UpdateAlpha
+	virtual bool UsesPackedAlpha() const override { return false; }
+
+private:
+
+	TSharedPtr<const FCDCameraProgram> Program;
+	int32 RunIndex;
+	FCDCameraProgramState State;
+
+	FCDCameraProgramContext MakeContext(float DeltaTime) const;
+};
@@ -59,10 +59,45 @@ public:
 		meta = (EditCondition = "RotationOverrideType == ECDRotationOverrideType::CAMROT_SceneComponent",
 			EditConditionHides))
 	USceneComponent* LookAtComponent;
+
+	/** Rotator camera parameter that drives RotationOverride */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics|Parameters")
+	FCDCameraParameterBinding RotationOverrideParameter;
+
+	/** Vector camera parameter that drives LookAtLocation */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics|Parameters")
+	FCDCameraParameterBinding LookAtLocationParameter;
+
+	/** Object camera parameter that drives LookAtActor */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Dynamics|Parameters")
+	FCDCameraParameterBinding LookAtActorParameter;
+
+	virtual void GetParameterBindings(TArray<const FCDCameraParameterBinding*>& OutBindings) const override;
 	
 protected:
 
+	virtual void AddedToCamera(APlayerCameraManager* Camera) override;
+
 	virtual bool ProcessViewRotationBlended(AActor* ViewTarget, float DeltaTime, FRotator& OutViewRotation, FRotator& OutDeltaRot) override;
 
+	virtual bool GetChannelUsage(FCDChannelUsage& OutUsage) const override;
+
+	virtual void ResumeFromMasked(ECDCameraChannels Pass, const FCDCameraPose& ViewPose) override;
+
+	virtual void ReadParameters(const FCDCameraBlackboard& Blackboard) override;
+
 	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
+
+private:
+
+	/** Get the rotation for the current override type */
+	FRotator SolveTargetRotation() const;
+
+	/** Solve the target rotation at the modifier's update rate, interpolating the solves in between */
+	FRotator GetReducedRateTargetRotation(float DeltaTime);
+
+	/** The view rotation is processed separately to the camera pose, so it has its own timer */
+	FCDUpdateRateTimer TargetUpdateTimer;
+	FQuat PreviousTargetRotation = FQuat::Identity;
+	FQuat LatestTargetRotation = FQuat::Identity;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Data/CameraDynamicDataTypes.h"
+#include "CDCameraQuerySubsystem.h"
 #include "Modifiers/CDCameraModifier_Instanced.h"
 #include "CDCameraModifier_Sweep_Basic.generated.h"
 
@@ -50,18 +51,95 @@ public:
 	/** Data for the camera trace */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics", meta = (FullyExpand))
 	FCameraTraceData CameraTraceData;
+
+	/**
+	 * Use the async trace API instead of sweeping during the camera update. The result of last frame's sweep is applied
+	 * as a fraction along this frame's trace, so it follows the camera's own motion.
+	 * Async modifiers aren't compiled into camera programs.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Async")
+	bool bUseAsyncSweep;
+
+	/**
+	 * If the trace start or end has moved further than this since the async sweep was issued, sweep synchronously instead,
+	 * as the result is likely to be wrong.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Async", meta = (EditCondition = "bUseAsyncSweep", ClampMin = "0.0", Units = "Centimeters"))
+	float MaxAsyncTraceMovement;
+
+	/**
+	 * Reuse the last synchronous sweep while the trace start and end stay within SweepCacheTolerance of it.
+	 * Static geometry can't have changed, so this is mostly useful for idle and slow moving cameras.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Cache")
+	bool bUseSweepCache;
+
+	/** How far the trace start and end can move before the cached sweep is no longer used */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Cache", meta = (EditCondition = "bUseSweepCache", ClampMin = "0.0", Units = "Centimeters"))
+	float SweepCacheTolerance;
+
+	/**
+	 * Check for dynamic objects inside the bounds of the cached sweep before reusing it. This is an overlap test against
+	 * dynamic objects only, which is much cheaper than the sweep. Disable if nothing dynamic blocks the trace channel.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Cache", meta = (EditCondition = "bUseSweepCache"))
+	bool bCheckDynamicObjectsForCache;
+
+	/**
+	 * Get the sweep cache counters.
+	 * @param Queries - Number of times the cache was checked.
+	 * @param Hits - Number of sweeps skipped by using the cache.
+	 * @param HitRate - Hits / Queries.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Camera Dynamics|Cache")
+	void GetSweepCacheStats(int32& Queries, int32& Hits, float& HitRate) const;
 	
 protected:
 
-	virtual void ModifyCamera(float DeltaTime, FVector ViewLocation, FRotator ViewRotation, float FOV,
-	                          FVector& NewViewLocation, FRotator& NewViewRotation, float& NewFOV) override;
+	virtual void AddedToCamera(APlayerCameraManager* Camera) override;
+
+	virtual void ModifyPose(float DeltaTime, FCDCameraPose& InOutPose) override;
 
 	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
 
 private:
 
+	/** Sweep along the trace during the camera update. Returns the location the camera should be moved to. */
+	FVector SweepSync(UCDCameraQuerySubsystem& Queries, const FCDCameraQuery& Query);
+
+	/** Get the camera location from the cached sweep, if it is still valid for the current trace */
+	bool TryUseSweepCache(UCDCameraQuerySubsystem& Queries, const FCDCameraQuery& Query, FVector& OutLocation);
+
+	/** Use last frame's async sweep if it is still usable, or sweep synchronously. Then issue this frame's async sweep. */
+	FVector SweepAsync(UCDCameraQuerySubsystem& Queries, const FCDCameraQuery& Query);
+
 	FVector TraceStart;
 	FVector TraceEnd;
 	FVector TraceHit;
+
+	/** Async sweep issued last frame, waiting to be read */
+	FTraceHandle PendingTraceHandle;
+	FVector PendingTraceStart;
+	FVector PendingTraceEnd;
+
+	/** Result of the last async sweep that was read */
+	bool bHasAsyncResult;
+	FCDCameraQueryResult AsyncResult;
+	FVector AsyncResultStart;
+	FVector AsyncResultEnd;
+
+	/** Number of frames that had to sweep synchronously in async mode, shown in the debug display */
+	int32 SyncFallbacks;
+
+	/** The last synchronous sweep */
+	bool bHasCachedSweep;
+	FCDCameraQueryResult CachedSweepResult;
+	float CachedSweepRadius;
+	TEnumAsByte<ECollisionChannel> CachedSweepChannel;
+	FVector CachedSweepStart;
+	FVector CachedSweepEnd;
+
+	int32 SweepCacheQueries;
+	int32 SweepCacheHits;
 	
 };
@@ -0,0 +1,145 @@
+﻿// Copyright (c) 2024, Evelyn Schwab. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CDCameraQuerySubsystem.h"
+#include "Modifiers/CDCameraModifier_Instanced.h"
+#include "Modifiers/CDCameraModifier_Sweep_Basic.h"
+#include "CDCameraModifier_Sweep_Predictive.generated.h"
+
+/** A single probe of the predictive sweep. Results are kept across frames until the probe is refreshed. */
+struct FCDSweepProbe
+{
+	/** Angle of the probe from the predicted trace, in degrees */
+	float Angle = 0.0f;
+	/** How much a hit on this probe pulls the camera in, 0 - 1 */
+	float Weight = 1.0f;
+
+	/** Async sweep issued for this probe, waiting to be read */
+	FTraceHandle PendingHandle;
+	FVector PendingStart = FVector::ZeroVector;
+	FVector PendingEnd = FVector::ZeroVector;
+
+	/** Result of the last sweep that was read */
+	bool bHasResult = false;
+	FCDCameraQueryResult Result;
+	FVector ResultStart = FVector::ZeroVector;
+	FVector ResultEnd = FVector::ZeroVector;
+};
+
+/**
+ * Predictive collision for the camera. Along with the current trace, a fan of probes is swept ahead of the camera's
+ * motion, using the camera and pawn velocity, so the camera starts pulling in before it is occluded.
+ *
+ * Every probe is an async sweep, issued together so they are run as one batch by the world's async trace task and read
+ * the next frame. The current trace is refreshed every frame, the other probes are refreshed on a rotating schedule and
+ * their last result is used until then.
+ */
+UCLASS(DisplayName = "Camera Modifier - Sweep - Predictive Sweep")
+class CAMERADYNAMICS_API UCDCameraModifier_Sweep_Predictive : public UCDCameraModifierInstanced
+{
+	GENERATED_BODY()
+
+public:
+
+	UCDCameraModifier_Sweep_Predictive();
+
+	/** Data for the camera trace, used by every probe */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics", meta = (FullyExpand))
+	FCameraTraceData CameraTraceData;
+
+	/** How far ahead the camera and pawn motion is predicted */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Prediction", meta = (ClampMin = "0.0", Units = "Seconds"))
+	float PredictionTime;
+
+	/** Move the start of the predicted trace by the pawn's velocity, as well as moving the end by the camera's velocity */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Prediction")
+	bool bPredictPawnMovement;
+
+	/** Number of probes fanned out around the predicted trace, in the direction of the camera's motion */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Prediction", meta = (ClampMin = "0", ClampMax = "16"))
+	int32 NumWhiskers;
+
+	/** Total angle covered by the whiskers */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Prediction", meta = (ClampMin = "0.0", ClampMax = "180.0", Units = "Degrees"))
+	float WhiskerFanAngle;
+
+	/** How much a hit on the outermost whiskers pulls the camera in, compared to a hit on the predicted trace */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Prediction", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float WhiskerInfluence;
+
+	/** Number of predicted probes refreshed each frame. The current trace is always refreshed. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Prediction", meta = (ClampMin = "1"))
+	int32 ProbesPerFrame;
+
+	/** Interp speed when pulling the camera in for a predicted hit */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Prediction", meta = (ClampMin = "0.0"))
+	float PullInSpeed;
+
+	/** Interp speed when moving the camera back out once predicted hits have cleared */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics|Prediction", meta = (ClampMin = "0.0"))
+	float ReturnSpeed;
+
+	/**
+	 * If the current trace has moved further than this since its last async sweep was issued, sweep it synchronously
+	 * instead, so the camera can't clip.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Camera Dynamics", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float MaxProbeMovement;
+
+protected:
+
+	virtual void AddedToCamera(APlayerCameraManager* Camera) override;
+
+	virtual void ModifyPose(float DeltaTime, FCDCameraPose& InOutPose) override;
+
+	virtual void DisplayDebug(UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
+
+private:
+
+	/** Set up the probes from NumWhiskers and WhiskerFanAngle */
+	void BuildProbes();
+
+	/** Read any async sweeps that have finished */
+	void ReadProbes(const UCDCameraQuerySubsystem& Queries);
+
+	/** Issue an async sweep for a probe */
+	void IssueProbe(UCDCameraQuerySubsystem& Queries, FCDSweepProbe& Probe, const FVector& Start, const FVector& End);
+
+	/** Get the hit fraction of the current trace, sweeping synchronously if the last async result is too old */
+	float GetCurrentTraceFraction(UCDCameraQuerySubsystem& Queries);
+
+	/** Build a sweep along a segment using the camera trace data */
+	FCDCameraQuery MakeQuery(const FVector& Start, const FVector& End) const;
+
+	/** Get the end of a predicted probe */
+	static FVector GetProbeEnd(const FVector& Start, const FVector& End, const FVector& Axis, float Angle);
+
+	/** Index 0 is the current trace, 1 the predicted trace and the rest are whiskers */
+	TArray<FCDSweepProbe> Probes;
+
+	/** Next predicted probe to refresh */
+	int32 NextProbe;
+
+	/** Distance of the camera from the trace start, smoothed towards the predicted distance */
+	float CurrentDistance;
+	float PredictedDistance;
+	bool bHasDistance;
+
+	FVector TraceStart;
+	FVector TraceEnd;
+	FVector LastTraceEnd;
+	bool bHasLastTraceEnd;
+
+	/** Predicted probes from the last time they were issued, for the debug display */
+	FVector PredictedStart;
+	FVector PredictedEnd;
+	FVector FanAxis;
+
+	/** Number of frames the current trace had to be swept synchronously, shown in the debug display */
+	int32 SyncFallbacks;
+	/** Number of probes issued last frame */
+	int32 ProbesIssued;
+
+};